@@ -0,0 +1,182 @@
+#include <filesystem>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/containers.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/operational_space_controller.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using operational_space_controller::ControlLoopMode;
+using rules_cc::cc::runfiles::Runfiles;
+
+
+struct BenchmarkResult {
+    double throughput_hz;
+    double mean_latency_us;
+    double max_latency_us;
+    double mean_model_stage_us;
+    double mean_solver_stage_us;
+    uint64_t overruns;
+    double position_rms_error;
+};
+
+State get_state(const mjData* mj_data) {
+    Vector<model::nq_size> qpos = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos);
+    Vector<model::nv_size> qvel = Eigen::Map<Vector<model::nv_size>>(mj_data->qvel);
+    Vector<model::nv_size> qfrc_actuator = Eigen::Map<Vector<model::nv_size>>(mj_data->qfrc_actuator);
+
+    State state;
+    state.motor_position = qpos(Eigen::seqN(7, model::nu_size));
+    state.motor_velocity = qvel(Eigen::seqN(6, model::nu_size));
+    state.torque_estimate = qfrc_actuator(Eigen::seqN(6, model::nu_size));
+    state.body_rotation = qpos(Eigen::seqN(3, 4));
+    state.linear_body_velocity = qvel(Eigen::seqN(0, 3));
+    state.angular_body_velocity = qvel(Eigen::seqN(3, 3));
+    state.contact_mask = Vector<model::contact_site_ids_size>::Constant(1.0);
+    return state;
+}
+
+// Standing scenario: Simulation is paced to wall clock time so the controller threads run at their real rate.
+// trace_path: Chrome/Perfetto trace of the run (disabled if empty)
+BenchmarkResult run_standing(
+    const std::filesystem::path& osc_model_path,
+    const std::filesystem::path& simulation_model_path,
+    ControlLoopMode mode,
+    int control_rate_us,
+    double duration,
+    const std::filesystem::path& trace_path
+) {
+    char mj_error[1000];
+    mjModel* mj_model = mj_loadXML(simulation_model_path.c_str(), nullptr, mj_error, 1000);
+    ABSL_CHECK(mj_model) << mj_error;
+    mjData* mj_data = mj_makeData(mj_model);
+    mj_resetDataKeyframe(mj_model, mj_data, 0);
+    mj_forward(mj_model, mj_data);
+
+    OperationalSpaceController controller(osc_model_path, control_rate_us);
+    State state = get_state(mj_data);
+    Vector<3> initial_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+
+    absl::Status result;
+    result.Update(controller.initialize(state));
+    result.Update(controller.initialize_optimization());
+    if(!trace_path.empty())
+        result.Update(controller.enable_tracing(trace_path));
+    controller.update_taskspace_targets(TaskspaceTargets::Zero());
+    result.Update(controller.initialize_thread(mode));
+    ABSL_CHECK(result.ok()) << result.message();
+
+    using Clock = std::chrono::steady_clock;
+    auto start_time = Clock::now();
+    auto next_time = start_time;
+    auto step_period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(mj_model->opt.timestep));
+    double squared_error = 0.0;
+    double latency_sum = 0.0;
+    double model_stage_sum = 0.0;
+    double solver_stage_sum = 0.0;
+    int samples = 0;
+    while(mj_data->time < duration) {
+        state = get_state(mj_data);
+        controller.update_state(state);
+
+        // Standing Targets:
+        TaskspaceTargets taskspace_targets = TaskspaceTargets::Zero();
+        Eigen::Quaternion<double> body_rotation = Eigen::Quaternion<double>(state.body_rotation(0), state.body_rotation(1), state.body_rotation(2), state.body_rotation(3));
+        Vector<3> body_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+        Vector<3> position_error = initial_position - body_position;
+        Vector<3> velocity_error = Vector<3>::Zero() - state.linear_body_velocity;
+        Vector<3> rotation_error = (Eigen::Quaternion<double>(1, 0, 0, 0) * body_rotation.conjugate()).vec();
+        Vector<3> angular_velocity_error = Vector<3>::Zero() - state.angular_body_velocity;
+        Vector<3> linear_control = 150.0 * (position_error) + 25.0 * (velocity_error);
+        Vector<3> angular_control = 50.0 * (rotation_error) + 10.0 * (angular_velocity_error);
+        taskspace_targets.row(0) << linear_control.transpose(), angular_control.transpose();
+        controller.update_taskspace_targets(taskspace_targets);
+
+        Vector<model::nu_size> torque_command = controller.get_torque_command();
+        mju_copy(mj_data->ctrl, torque_command.data(), model::nu_size);
+        mj_step(mj_model, mj_data);
+
+        auto statistics = controller.get_statistics();
+        squared_error += position_error.squaredNorm();
+        latency_sum += statistics.latency_us;
+        model_stage_sum += statistics.model_stage_us;
+        solver_stage_sum += statistics.solver_stage_us;
+        samples++;
+
+        next_time += step_period;
+        std::this_thread::sleep_until(next_time);
+    }
+    double wall_time = std::chrono::duration<double>(Clock::now() - start_time).count();
+
+    result.Update(controller.stop_thread());
+    result.Update(controller.clean_up());
+    ABSL_CHECK(result.ok()) << result.message();
+
+    auto statistics = controller.get_statistics();
+    BenchmarkResult benchmark_result{
+        .throughput_hz = statistics.ticks / wall_time,
+        .mean_latency_us = latency_sum / samples,
+        .max_latency_us = statistics.max_latency_us,
+        .mean_model_stage_us = model_stage_sum / samples,
+        .mean_solver_stage_us = solver_stage_sum / samples,
+        .overruns = statistics.overruns,
+        .position_rms_error = std::sqrt(squared_error / samples),
+    };
+
+    mj_deleteData(mj_data);
+    mj_deleteModel(mj_model);
+    return benchmark_result;
+}
+
+
+int main(int argc, char** argv) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::Create(argv[0], BAZEL_CURRENT_REPOSITORY, &error)
+    );
+    std::filesystem::path osc_model_path = 
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+    std::filesystem::path simulation_model_path = 
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/scene_go2.xml");
+
+    // Usage: control_loop [duration_s] [trace_directory]
+    const double duration = argc > 1 ? std::atof(argv[1]) : 5.0;
+    const std::filesystem::path trace_directory = argc > 2 ? argv[2] : "";
+    const std::vector<int> control_rates_us = {2000, 1000, 500};
+
+    std::cout << std::setw(12) << "mode" << std::setw(10) << "rate_us"
+        << std::setw(14) << "ticks/s" << std::setw(14) << "latency_us" << std::setw(14) << "max_lat_us"
+        << std::setw(12) << "model_us" << std::setw(12) << "solver_us"
+        << std::setw(10) << "overruns" << std::setw(14) << "pos_rms_m" << std::endl;
+    for(int control_rate_us : control_rates_us) {
+        for(ControlLoopMode mode : {ControlLoopMode::kSequential, ControlLoopMode::kPipelined}) {
+            const std::string mode_name = mode == ControlLoopMode::kPipelined ? "pipelined" : "sequential";
+            const std::filesystem::path trace_path = trace_directory.empty() ? std::filesystem::path() :
+                trace_directory / ("control_loop_" + mode_name + "_" + std::to_string(control_rate_us) + "us.json");
+            BenchmarkResult r = run_standing(osc_model_path, simulation_model_path, mode, control_rate_us, duration, trace_path);
+            std::cout << std::setw(12) << mode_name
+                << std::setw(10) << control_rate_us
+                << std::setw(14) << r.throughput_hz << std::setw(14) << r.mean_latency_us << std::setw(14) << r.max_latency_us
+                << std::setw(12) << r.mean_model_stage_us << std::setw(12) << r.mean_solver_stage_us
+                << std::setw(10) << r.overruns << std::setw(14) << r.position_rms_error << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,236 @@
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/containers.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/operational_space_controller.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using rules_cc::cc::runfiles::Runfiles;
+
+
+/*
+    Hot Restart Benchmark: Controller failover with and without a checkpoint.
+    A checkpointing controller balances the Go2 under random base pushes and is dropped mid push.
+    Replacement controllers then take over the same simulation, either cold (initialize_optimization)
+    or from the checkpoint (restore_checkpoint). Reports the restart time, the first tick's solver stage,
+    the torque jump relative to the last command of the dropped controller and whether the robot kept standing.
+        Usage: hot_restart [duration_s] [checkpoint_path]
+*/
+// Random base pushes: (Copied with the simulation state at the failover)
+struct Pushes {
+    std::mt19937 generator{0};
+    Vector<2> force = Vector<2>::Zero();
+};
+
+struct RestartResult {
+    double initialize_us = 0.0;
+    double optimization_us = 0.0;
+    double first_solver_stage_us = 0.0;
+    double torque_jump = 0.0;
+    bool fell = false;
+};
+
+State get_state(const mjData* mj_data) {
+    Vector<model::nq_size> qpos = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos);
+    Vector<model::nv_size> qvel = Eigen::Map<Vector<model::nv_size>>(mj_data->qvel);
+    Vector<model::nv_size> qfrc_actuator = Eigen::Map<Vector<model::nv_size>>(mj_data->qfrc_actuator);
+
+    State state;
+    state.motor_position = qpos(Eigen::seqN(7, model::nu_size));
+    state.motor_velocity = qvel(Eigen::seqN(6, model::nu_size));
+    state.motor_acceleration = Vector<model::nu_size>::Zero();
+    state.torque_estimate = qfrc_actuator(Eigen::seqN(6, model::nu_size));
+    state.body_rotation = qpos(Eigen::seqN(3, 4));
+    state.linear_body_velocity = qvel(Eigen::seqN(0, 3));
+    state.angular_body_velocity = qvel(Eigen::seqN(3, 3));
+    state.linear_body_acceleration = Vector<3>::Zero();
+    state.contact_mask = Vector<model::contact_site_ids_size>::Constant(1.0);
+    return state;
+}
+
+// Standing Targets: (Same gains as scenario_runner)
+TaskspaceTargets standing_targets(const mjData* mj_data, const State& state, const Vector<3>& nominal_position) {
+    Vector<3> body_position = Eigen::Map<const Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+    Eigen::Quaternion<double> body_rotation = Eigen::Quaternion<double>(state.body_rotation(0), state.body_rotation(1), state.body_rotation(2), state.body_rotation(3));
+    Vector<3> position_error = nominal_position - body_position;
+    Vector<3> velocity_error = Vector<3>::Zero() - state.linear_body_velocity;
+    Vector<3> rotation_error = (Eigen::Quaternion<double>(1, 0, 0, 0) * body_rotation.conjugate()).vec();
+    Vector<3> angular_velocity_error = Vector<3>::Zero() - state.angular_body_velocity;
+    Vector<3> linear_control = 150.0 * (position_error) + 25.0 * (velocity_error);
+    Vector<3> angular_control = 50.0 * (rotation_error) + 10.0 * (angular_velocity_error);
+    TaskspaceTargets taskspace_targets = TaskspaceTargets::Zero();
+    taskspace_targets.row(0) << linear_control.transpose(), angular_control.transpose();
+    return taskspace_targets;
+}
+
+double elapsed_us(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+    Closed loop simulation at 500 Hz until end_time: (Random base pushes, 0.1 s every 0.5 s)
+    Returns false if the robot fell.
+*/
+bool simulate(
+    OperationalSpaceController& controller,
+    const mjModel* mj_model,
+    mjData* mj_data,
+    double end_time,
+    const Vector<3>& nominal_position,
+    Pushes& pushes,
+    Vector<model::nu_size>& torque_command,
+    double* first_solver_stage_us = nullptr
+) {
+    const int base_body = mj_name2id(mj_model, mjOBJ_BODY, "base_link");
+    ABSL_CHECK(base_body >= 0) << "base_link not found.";
+    std::uniform_real_distribution<double> direction(0.0, 2.0 * M_PI);
+    const double push_force = 60.0;
+    const int qp_decimation = std::max(1, static_cast<int>(std::round(0.002 / mj_model->opt.timestep)));
+
+    absl::Status result;
+    uint64_t simulation_steps = 0;
+    while(mj_data->time < end_time) {
+        const double push_phase = std::fmod(mj_data->time, 0.5);
+        if(push_phase < mj_model->opt.timestep) {
+            const double angle = direction(pushes.generator);
+            pushes.force << push_force * std::cos(angle), push_force * std::sin(angle);
+        }
+        mj_data->xfrc_applied[6 * base_body + 0] = push_phase < 0.1 ? pushes.force(0) : 0.0;
+        mj_data->xfrc_applied[6 * base_body + 1] = push_phase < 0.1 ? pushes.force(1) : 0.0;
+
+        if(simulation_steps % qp_decimation == 0) {
+            const State state = get_state(mj_data);
+            controller.update_state(state);
+            controller.update_taskspace_targets(standing_targets(mj_data, state, nominal_position));
+            result.Update(controller.step(static_cast<int64_t>(std::llround(1e9 * mj_data->time))));
+            torque_command = controller.get_torque_command();
+            if(first_solver_stage_us != nullptr) {
+                *first_solver_stage_us = controller.get_statistics().solver_stage_us;
+                first_solver_stage_us = nullptr;
+            }
+        }
+
+        mju_copy(mj_data->ctrl, torque_command.data(), model::nu_size);
+        mj_step(mj_model, mj_data);
+        simulation_steps++;
+
+        if(mj_data->qpos[2] < 0.5 * nominal_position(2))
+            return false;
+    }
+    ABSL_CHECK(result.ok()) << result.message();
+    return true;
+}
+
+
+int main(int argc, char** argv) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::Create(argv[0], BAZEL_CURRENT_REPOSITORY, &error)
+    );
+    std::filesystem::path osc_model_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+    std::filesystem::path simulation_model_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/scene_go2.xml");
+
+    const double duration = argc > 1 ? std::atof(argv[1]) : 2.0;
+    const std::filesystem::path checkpoint_path = argc > 2 ?
+        std::filesystem::path(argv[2]) : std::filesystem::temp_directory_path() / "osc_hot_restart.checkpoint";
+    std::filesystem::remove(checkpoint_path);
+
+    char mj_error[1000];
+    mjModel* mj_model = mj_loadXML(simulation_model_path.c_str(), nullptr, mj_error, 1000);
+    ABSL_CHECK(mj_model) << mj_error;
+    mjData* mj_data = mj_makeData(mj_model);
+    mj_resetDataKeyframe(mj_model, mj_data, 0);
+    mj_forward(mj_model, mj_data);
+    const Vector<3> nominal_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+
+    // Checkpointing controller, dropped mid push: (0.05 s into the push after duration)
+    Pushes pushes;
+    Vector<model::nu_size> last_torque_command = Vector<model::nu_size>::Zero();
+    {
+        OperationalSpaceController controller(osc_model_path);
+        absl::Status result = controller.initialize(get_state(mj_data));
+        result.Update(controller.initialize_optimization());
+        result.Update(controller.enable_checkpoint(checkpoint_path));
+        ABSL_CHECK(result.ok()) << result.message();
+        const double failover_time = 0.5 * std::ceil(duration / 0.5) + 0.05;
+        ABSL_CHECK(simulate(controller, mj_model, mj_data, failover_time, nominal_position, pushes, last_torque_command))
+            << "Fell before the failover.";
+        result.Update(controller.clean_up());
+        ABSL_CHECK(result.ok()) << result.message();
+    }
+
+    // Replacement controllers take over the same simulation state:
+    auto restart = [&](bool hot) {
+        mjData* restart_data = mj_copyData(nullptr, mj_model, mj_data);
+        Pushes restart_pushes = pushes;
+        const State state = get_state(restart_data);
+
+        RestartResult restart_result;
+        OperationalSpaceController controller(osc_model_path);
+        auto start = std::chrono::steady_clock::now();
+        absl::Status result = controller.initialize(state);
+        restart_result.initialize_us = elapsed_us(start);
+
+        start = std::chrono::steady_clock::now();
+        result.Update(hot ? controller.restore_checkpoint(checkpoint_path) : controller.initialize_optimization());
+        restart_result.optimization_us = elapsed_us(start);
+        ABSL_CHECK(result.ok()) << result.message();
+
+        // First tick of the replacement, then 1 s of pushes:
+        Vector<model::nu_size> torque_command = last_torque_command;
+        const double end_time = restart_data->time + 1.0;
+        restart_result.fell = !simulate(
+            controller, mj_model, restart_data, restart_data->time + 0.002 - 0.5 * mj_model->opt.timestep, nominal_position,
+            restart_pushes, torque_command, &restart_result.first_solver_stage_us
+        );
+        restart_result.torque_jump = (torque_command - last_torque_command).cwiseAbs().maxCoeff();
+        if(!restart_result.fell)
+            restart_result.fell = !simulate(controller, mj_model, restart_data, end_time, nominal_position, restart_pushes, torque_command);
+
+        result.Update(controller.clean_up());
+        ABSL_CHECK(result.ok()) << result.message();
+        mj_deleteData(restart_data);
+        return restart_result;
+    };
+
+    std::cout << "Failover " << std::fixed << std::setprecision(2) << mj_data->time << "s into the run:" << std::endl;
+    std::cout << std::setw(10) << "restart" << std::setw(16) << "initialize us" << std::setw(18) << "optimization us"
+        << std::setw(20) << "first solve us" << std::setw(20) << "torque jump Nm" << std::endl;
+    std::cout << std::setprecision(1);
+    bool fell = false;
+    for(const bool hot : {false, true}) {
+        const RestartResult restart_result = restart(hot);
+        std::cout << std::setw(10) << (hot ? "hot" : "cold")
+            << std::setw(16) << restart_result.initialize_us
+            << std::setw(18) << restart_result.optimization_us
+            << std::setw(20) << restart_result.first_solver_stage_us
+            << std::setw(20) << std::setprecision(3) << restart_result.torque_jump << std::setprecision(1)
+            << (restart_result.fell ? "  FELL" : "") << std::endl;
+        fell |= restart_result.fell;
+    }
+
+    std::filesystem::remove(checkpoint_path);
+    mj_deleteData(mj_data);
+    mj_deleteModel(mj_model);
+    return fell ? 2 : 0;
+}
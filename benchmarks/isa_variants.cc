@@ -0,0 +1,217 @@
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "benchmark/benchmark.h"
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/utilities.h"
+#include "operational-space-control/function_utilities.h"
+#include "operational-space-control/isa_dispatch.h"
+#include "operational-space-control/osc_data.h"
+#include "operational-space-control/qp_assembly.h"
+#include "operational-space-control/controller_model.h"
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/containers.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using operational_space_controller::isa_dispatch::IsaVariant;
+using functions = Descriptor::functions;
+using rules_cc::cc::runfiles::Runfiles;
+
+namespace isa_dispatch = operational_space_controller::isa_dispatch;
+
+
+/*
+    ISA Variant Benchmark: Hot kernels of the control tick per instruction set variant.
+    Every variant supported by this CPU is registered, e.g. BM_EvaluateFunction_H/avx2.
+        Generated functions : Casadi H, f and Aeq from Descriptor::functions::isa_variants
+        Dense kernels       : Taskspace bias (gemv) and J^T W J (weighted_gram_upper)
+        Assembly            : update_osc_data and StructuredAssembly::update_objective with the variant active
+    Inputs are captured from the Go2 keyframe.
+*/
+struct KeyframeInputs {
+    operational_space_controller::controller_model::ControllerModel<Descriptor>::SharedModel model;
+    mjData* mj_data = nullptr;
+    Matrix<model::site_ids_size, 3> points;
+    OSCData osc_data;
+    TaskspaceTargets taskspace_targets = TaskspaceTargets::Zero();
+    OptimizationSolution design_vector = OptimizationSolution::Zero();
+    Vector<optimization::weights_size> weights_vector;
+    Vector<optimization::s_size> task_weights;
+    // Column Major Casadi Arguments:
+    MatrixColMajor<model::nv_size, model::nv_size> mass_matrix;
+    MatrixColMajor<model::nv_size, 1> coriolis_matrix;
+    MatrixColMajor<model::nv_size, optimization::z_size> contact_jacobian;
+    MatrixColMajor<optimization::s_size, model::nv_size> taskspace_jacobian;
+    MatrixColMajor<optimization::s_size, 1> taskspace_bias;
+    MatrixColMajor<model::site_ids_size, 6> desired_taskspace_ddx;
+};
+
+KeyframeInputs inputs;
+
+absl::Status set_up_inputs(const std::filesystem::path& xml_path) {
+    auto controller_model = operational_space_controller::controller_model::ControllerModel<Descriptor>::load(xml_path);
+    if(!controller_model.ok())
+        return controller_model.status();
+    inputs.model = *controller_model;
+    const mjModel* mj_model = inputs.model->mujoco_model();
+    inputs.mj_data = mj_makeData(mj_model);
+
+    mj_resetDataKeyframe(mj_model, inputs.mj_data, 0);
+    mju_zero(inputs.mj_data->qpos, 3);
+    mj_fwdPosition(mj_model, inputs.mj_data);
+    mj_fwdVelocity(mj_model, inputs.mj_data);
+    inputs.points = Eigen::Map<Matrix<model::site_ids_size, 3>>(inputs.mj_data->site_xpos);
+    operational_space_controller::osc_data::update_osc_data<Descriptor>(
+        mj_model, inputs.mj_data, inputs.points, inputs.model->body_ids(), inputs.osc_data
+    );
+
+    Weights weights = Weights::defaults();
+    inputs.weights_vector << weights.task, weights.torque, weights.regularization;
+    inputs.task_weights = weights.task;
+    inputs.mass_matrix = inputs.osc_data.mass_matrix;
+    inputs.coriolis_matrix = inputs.osc_data.coriolis_matrix;
+    inputs.contact_jacobian = inputs.osc_data.contact_jacobian;
+    inputs.taskspace_jacobian = inputs.osc_data.taskspace_jacobian;
+    inputs.taskspace_bias = inputs.osc_data.taskspace_bias;
+    inputs.desired_taskspace_ddx = inputs.taskspace_targets;
+    return absl::OkStatus();
+}
+
+void clean_up_inputs() {
+    mj_deleteData(inputs.mj_data);
+    inputs.model.reset();
+}
+
+
+/* Casadi Generated Functions: */
+template <typename Params>
+void evaluate(benchmark::State& state, const FunctionOperations<typename Params::Scalar>& ops, const std::array<typename Params::Scalar*, Params::num_args>& arguments) {
+    for(auto _ : state) {
+        auto result = evaluate_function<Params>(ops, arguments);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+void BM_EvaluateFunction_H(benchmark::State& state, IsaVariant variant) {
+    const auto& table = functions::isa_variants[static_cast<int>(variant)];
+    evaluate<functions::HParams>(state, table.H, {inputs.design_vector.data(), inputs.desired_taskspace_ddx.data(), inputs.taskspace_jacobian.data(), inputs.taskspace_bias.data(), inputs.weights_vector.data()});
+}
+
+void BM_EvaluateFunction_f(benchmark::State& state, IsaVariant variant) {
+    const auto& table = functions::isa_variants[static_cast<int>(variant)];
+    evaluate<functions::fParams>(state, table.f, {inputs.design_vector.data(), inputs.desired_taskspace_ddx.data(), inputs.taskspace_jacobian.data(), inputs.taskspace_bias.data(), inputs.weights_vector.data()});
+}
+
+void BM_EvaluateFunction_Aeq(benchmark::State& state, IsaVariant variant) {
+    const auto& table = functions::isa_variants[static_cast<int>(variant)];
+    evaluate<functions::AeqParams>(state, table.Aeq, {inputs.design_vector.data(), inputs.mass_matrix.data(), inputs.coriolis_matrix.data(), inputs.contact_jacobian.data()});
+}
+
+/* Dense Kernels: */
+void BM_TaskspaceBias(benchmark::State& state, IsaVariant variant) {
+    const auto& kernels = isa_dispatch::kernels<double>(variant);
+    const Matrix<optimization::s_size, model::nv_size> jacobian_dot = inputs.osc_data.taskspace_jacobian;
+    const Vector<model::nv_size> qvel = Vector<model::nv_size>::Ones();
+    Vector<optimization::s_size> taskspace_bias;
+    for(auto _ : state) {
+        kernels.gemv(jacobian_dot.data(), qvel.data(), taskspace_bias.data(), optimization::s_size, model::nv_size);
+        benchmark::DoNotOptimize(taskspace_bias);
+    }
+}
+
+void BM_WeightedGram(benchmark::State& state, IsaVariant variant) {
+    const auto& kernels = isa_dispatch::kernels<double>(variant);
+    MatrixColMajor<model::nv_size, model::nv_size> H;
+    for(auto _ : state) {
+        H.setZero();
+        kernels.weighted_gram_upper(
+            inputs.osc_data.taskspace_jacobian.data(), inputs.task_weights.data(), H.data(),
+            optimization::s_size, model::nv_size, model::nv_size, 2.0
+        );
+        benchmark::DoNotOptimize(H);
+    }
+}
+
+/* Assembly: (Dispatch through the process wide active variant) */
+void BM_UpdateOSCData(benchmark::State& state, IsaVariant variant) {
+    ABSL_CHECK(isa_dispatch::set_active_variant(variant).ok());
+    OSCData osc_data;
+    for(auto _ : state) {
+        operational_space_controller::osc_data::update_osc_data<Descriptor>(
+            inputs.model->mujoco_model(), inputs.mj_data, inputs.points, inputs.model->body_ids(), osc_data
+        );
+        benchmark::DoNotOptimize(osc_data);
+    }
+}
+
+void BM_UpdateObjective(benchmark::State& state, IsaVariant variant) {
+    ABSL_CHECK(isa_dispatch::set_active_variant(variant).ok());
+    operational_space_controller::qp_assembly::StructuredAssembly<Descriptor> structured_assembly;
+    OptimizationData opt_data;
+    structured_assembly.initialize(Weights::defaults(), optimization::friction_coefficient, opt_data);
+    for(auto _ : state) {
+        structured_assembly.update_objective(inputs.osc_data, inputs.taskspace_targets, inputs.design_vector, opt_data);
+        benchmark::DoNotOptimize(opt_data.H.data());
+        benchmark::DoNotOptimize(opt_data.f.data());
+    }
+}
+
+
+int main(int argc, char** argv) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::Create(argv[0], BAZEL_CURRENT_REPOSITORY, &error)
+    );
+    std::filesystem::path xml_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+
+    absl::Status result = set_up_inputs(xml_path);
+    ABSL_CHECK(result.ok()) << result.message();
+
+    const IsaVariant startup_variant = isa_dispatch::active_variant();
+    std::cout << "Active ISA variant: " << isa_dispatch::name(startup_variant) << std::endl;
+
+    using BenchmarkFunction = void (*)(benchmark::State&, IsaVariant);
+    const std::vector<std::pair<std::string, BenchmarkFunction>> benchmarks = {
+        {"BM_EvaluateFunction_H", BM_EvaluateFunction_H},
+        {"BM_EvaluateFunction_f", BM_EvaluateFunction_f},
+        {"BM_EvaluateFunction_Aeq", BM_EvaluateFunction_Aeq},
+        {"BM_TaskspaceBias", BM_TaskspaceBias},
+        {"BM_WeightedGram", BM_WeightedGram},
+        {"BM_UpdateOSCData", BM_UpdateOSCData},
+        {"BM_UpdateObjective", BM_UpdateObjective},
+    };
+    for(const auto& [name, function] : benchmarks) {
+        for(int i = 0; i < isa_dispatch::kNumIsaVariants; i++) {
+            const IsaVariant variant = static_cast<IsaVariant>(i);
+            if(!isa_dispatch::is_supported(variant))
+                continue;
+            const std::string benchmark_name = name + "/" + std::string(isa_dispatch::name(variant));
+            benchmark::RegisterBenchmark(benchmark_name.c_str(), [function, variant](benchmark::State& state) {
+                function(state, variant);
+            });
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    ABSL_CHECK(isa_dispatch::set_active_variant(startup_variant).ok());
+    clean_up_inputs();
+
+    return 0;
+}
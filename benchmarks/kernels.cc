@@ -0,0 +1,347 @@
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <iostream>
+
+#include "benchmark/benchmark.h"
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+#include "Eigen/SparseCore"
+#include "osqp++.h"
+#include "osqp.h"
+
+#include "operational-space-control/utilities.h"
+#include "operational-space-control/function_utilities.h"
+#include "operational-space-control/isa_dispatch.h"
+#include "operational-space-control/osc_data.h"
+#include "operational-space-control/target_trajectory.h"
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/containers.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using functions = Descriptor::functions;
+using limits = Descriptor::limits;
+using rules_cc::cc::runfiles::Runfiles;
+
+// Generated functions of the active ISA variant: (Same table as OperationalSpaceController)
+const FunctionTable<double>& casadi_functions() {
+    return functions::isa_variants[static_cast<int>(operational_space_controller::isa_dispatch::active_variant())];
+}
+
+
+/*
+    Fixed inputs captured from the Go2 keyframe: (Same data path as OperationalSpaceController)
+        Mujoco data after mj_fwdPosition and mj_fwdVelocity, OSCData, Column Major Casadi arguments,
+        Casadi assembled OptimizationData, the stacked constraint matrix, bounds and an initialized OSQP solver.
+*/
+struct KeyframeInputs {
+    mjModel* mj_model = nullptr;
+    mjData* mj_data = nullptr;
+    Matrix<model::site_ids_size, 3> points;
+    std::vector<int> body_ids;
+    OSCData osc_data;
+    TaskspaceTargets taskspace_targets = TaskspaceTargets::Zero();
+    OptimizationSolution design_vector = OptimizationSolution::Zero();
+    Vector<optimization::weights_size> weights_vector;
+    double friction_coefficient = optimization::friction_coefficient;
+    // Column Major Casadi Arguments:
+    MatrixColMajor<model::nv_size, model::nv_size> mass_matrix;
+    MatrixColMajor<model::nv_size, 1> coriolis_matrix;
+    MatrixColMajor<model::nv_size, optimization::z_size> contact_jacobian;
+    MatrixColMajor<optimization::s_size, model::nv_size> taskspace_jacobian;
+    MatrixColMajor<optimization::s_size, 1> taskspace_bias;
+    MatrixColMajor<model::site_ids_size, 6> desired_taskspace_ddx;
+    // QP:
+    OptimizationData opt_data;
+    MatrixColMajor<optimization::constraint_matrix_rows, optimization::constraint_matrix_cols> A;
+    Eigen::SparseMatrix<double> sparse_H;
+    Eigen::SparseMatrix<double> sparse_A;
+    Vector<optimization::bounds_size> lb;
+    Vector<optimization::bounds_size> ub;
+    osqp::OsqpSolver solver;
+    OptimizationSolution solution;
+    Vector<optimization::constraint_matrix_rows> dual_solution;
+};
+
+KeyframeInputs inputs;
+
+absl::Status set_up_inputs(const std::filesystem::path& xml_path) {
+    char error[1000];
+    inputs.mj_model = mj_loadXML(xml_path.c_str(), nullptr, error, 1000);
+    if(!inputs.mj_model) {
+        printf("%s\n", error);
+        return absl::InternalError("Failed to load Mujoco Model");
+    }
+    inputs.mj_model->opt.timestep = 0.002;
+    inputs.mj_data = mj_makeData(inputs.mj_model);
+
+    for(const std::string_view& body : model::body_list) {
+        std::string body_str = std::string(body);
+        int id = mj_name2id(inputs.mj_model, mjOBJ_BODY, body_str.data());
+        if(id == -1)
+            return absl::NotFoundError("Body not found in model.");
+        inputs.body_ids.push_back(id);
+    }
+
+    // Keyframe with the base at the origin:
+    mj_resetDataKeyframe(inputs.mj_model, inputs.mj_data, 0);
+    mju_zero(inputs.mj_data->qpos, 3);
+    mj_fwdPosition(inputs.mj_model, inputs.mj_data);
+    mj_fwdVelocity(inputs.mj_model, inputs.mj_data);
+    inputs.points = Eigen::Map<Matrix<model::site_ids_size, 3>>(inputs.mj_data->site_xpos);
+    operational_space_controller::osc_data::update_osc_data<Descriptor>(
+        inputs.mj_model, inputs.mj_data, inputs.points, inputs.body_ids, inputs.osc_data
+    );
+
+    Weights weights = Weights::defaults();
+    inputs.weights_vector << weights.task, weights.torque, weights.regularization;
+    inputs.mass_matrix = inputs.osc_data.mass_matrix;
+    inputs.coriolis_matrix = inputs.osc_data.coriolis_matrix;
+    inputs.contact_jacobian = inputs.osc_data.contact_jacobian;
+    inputs.taskspace_jacobian = inputs.osc_data.taskspace_jacobian;
+    inputs.taskspace_bias = inputs.osc_data.taskspace_bias;
+    inputs.desired_taskspace_ddx = inputs.taskspace_targets;
+
+    double* q = inputs.design_vector.data();
+    inputs.opt_data.Aeq = evaluate_function<functions::AeqParams>(casadi_functions().Aeq, {q, inputs.mass_matrix.data(), inputs.coriolis_matrix.data(), inputs.contact_jacobian.data()});
+    inputs.opt_data.beq = evaluate_function<functions::beqParams>(casadi_functions().beq, {q, inputs.mass_matrix.data(), inputs.coriolis_matrix.data(), inputs.contact_jacobian.data()});
+    inputs.opt_data.Aineq = evaluate_function<functions::AineqParams>(casadi_functions().Aineq, {q, &inputs.friction_coefficient});
+    inputs.opt_data.bineq = evaluate_function<functions::bineqParams>(casadi_functions().bineq, {q, &inputs.friction_coefficient});
+    inputs.opt_data.H = evaluate_function<functions::HParams>(casadi_functions().H, {q, inputs.desired_taskspace_ddx.data(), inputs.taskspace_jacobian.data(), inputs.taskspace_bias.data(), inputs.weights_vector.data()});
+    inputs.opt_data.f = evaluate_function<functions::fParams>(casadi_functions().f, {q, inputs.desired_taskspace_ddx.data(), inputs.taskspace_jacobian.data(), inputs.taskspace_bias.data(), inputs.weights_vector.data()});
+
+    // Constraint Matrix and Bounds: (All feet in contact)
+    const double infinity = OSQP_INFTY;
+    const double big_number = 1e4;
+    inputs.A << inputs.opt_data.Aeq, inputs.opt_data.Aineq,
+        MatrixColMajor<optimization::design_vector_size, optimization::design_vector_size>::Identity();
+    Vector<optimization::z_size> z_lb;
+    Vector<optimization::z_size> z_ub;
+    for(int i = 0; i < model::contact_site_ids_size; i++) {
+        z_lb.segment(3 * i, 3) << -infinity, -infinity, 0.0;
+        z_ub.segment(3 * i, 3) << infinity, infinity, big_number;
+    }
+    inputs.lb << inputs.opt_data.beq, Vector<optimization::bineq_sz>::Constant(-infinity),
+        Vector<optimization::dv_size>::Constant(-infinity),
+        Eigen::Map<const Vector<model::nu_size>>(limits::torque_lower_bound.data()), z_lb;
+    inputs.ub << inputs.opt_data.beq, inputs.opt_data.bineq,
+        Vector<optimization::dv_size>::Constant(infinity),
+        Eigen::Map<const Vector<model::nu_size>>(limits::torque_upper_bound.data()), z_ub;
+
+    inputs.sparse_H = inputs.opt_data.H.sparseView();
+    inputs.sparse_A = inputs.A.sparseView();
+    inputs.sparse_H.makeCompressed();
+    inputs.sparse_A.makeCompressed();
+
+    osqp::OsqpInstance instance;
+    instance.objective_matrix = inputs.sparse_H;
+    instance.objective_vector = inputs.opt_data.f;
+    instance.constraint_matrix = inputs.sparse_A;
+    instance.lower_bounds = inputs.lb;
+    instance.upper_bounds = inputs.ub;
+    absl::Status result = inputs.solver.Init(instance, osqp::OsqpSettings());
+    if(!result.ok())
+        return result;
+
+    // Converged solution for warm started solves:
+    inputs.solver.Solve();
+    inputs.solution = inputs.solver.primal_solution();
+    inputs.dual_solution = inputs.solver.dual_solution();
+
+    return absl::OkStatus();
+}
+
+void clean_up_inputs() {
+    mj_deleteData(inputs.mj_data);
+    mj_deleteModel(inputs.mj_model);
+}
+
+
+/* Mujoco: (OperationalSpaceController::update_mj_data) */
+void BM_ForwardKinematics(benchmark::State& state) {
+    for(auto _ : state) {
+        mj_fwdPosition(inputs.mj_model, inputs.mj_data);
+        mj_fwdVelocity(inputs.mj_model, inputs.mj_data);
+    }
+}
+BENCHMARK(BM_ForwardKinematics);
+
+/* Jacobian Assembly: (OperationalSpaceController::update_osc_data) */
+void BM_UpdateOSCData(benchmark::State& state) {
+    OSCData osc_data;
+    for(auto _ : state) {
+        operational_space_controller::osc_data::update_osc_data<Descriptor>(
+            inputs.mj_model, inputs.mj_data, inputs.points, inputs.body_ids, osc_data
+        );
+        benchmark::DoNotOptimize(osc_data);
+    }
+}
+BENCHMARK(BM_UpdateOSCData);
+
+/* Taskspace Trajectory: (OperationalSpaceController::evaluate_taskspace_trajectory, one cubic segment per tick) */
+void BM_EvaluateTaskspaceTrajectory(benchmark::State& state) {
+    using TargetTrajectory = operational_space_controller::target_trajectory::TargetTrajectory<Descriptor>;
+    auto trajectory = std::make_unique<TargetTrajectory>();
+    const TaskspaceTargets zero = TaskspaceTargets::Zero();
+    const std::array<TargetTrajectory::Segment, 1> segments = {
+        TargetTrajectory::Segment::cubic_hermite(0, 1'000'000'000, zero, zero, TaskspaceTargets::Ones(), zero)
+    };
+    ABSL_CHECK(trajectory->replace(segments).ok());
+    TaskspaceTargets targets;
+    int64_t time_ns = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(trajectory->evaluate(time_ns, targets));
+        benchmark::DoNotOptimize(targets);
+        time_ns = (time_ns + 2'000'000) % 1'000'000'000;
+    }
+}
+BENCHMARK(BM_EvaluateTaskspaceTrajectory);
+
+/* Row Major to Column Major Conversion: */
+template <std::size_t Rows, std::size_t Cols>
+void transform_matrix(benchmark::State& state, const double* data) {
+    for(auto _ : state) {
+        auto result = matrix_utils::transformMatrix<double, Rows, Cols, matrix_utils::ColumnMajor>(data);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+void BM_TransformMatrix_MassMatrix(benchmark::State& state) {
+    transform_matrix<model::nv_size, model::nv_size>(state, inputs.osc_data.mass_matrix.data());
+}
+BENCHMARK(BM_TransformMatrix_MassMatrix);
+
+void BM_TransformMatrix_ContactJacobian(benchmark::State& state) {
+    transform_matrix<model::nv_size, optimization::z_size>(state, inputs.osc_data.contact_jacobian.data());
+}
+BENCHMARK(BM_TransformMatrix_ContactJacobian);
+
+void BM_TransformMatrix_TaskspaceJacobian(benchmark::State& state) {
+    transform_matrix<optimization::s_size, model::nv_size>(state, inputs.osc_data.taskspace_jacobian.data());
+}
+BENCHMARK(BM_TransformMatrix_TaskspaceJacobian);
+
+/* Casadi Generated Functions: */
+template <typename Params>
+void evaluate(benchmark::State& state, const FunctionOperations<typename Params::Scalar>& ops, const std::array<typename Params::Scalar*, Params::num_args>& arguments) {
+    for(auto _ : state) {
+        auto result = evaluate_function<Params>(ops, arguments);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+void BM_EvaluateFunction_Aeq(benchmark::State& state) {
+    evaluate<functions::AeqParams>(state, casadi_functions().Aeq, {inputs.design_vector.data(), inputs.mass_matrix.data(), inputs.coriolis_matrix.data(), inputs.contact_jacobian.data()});
+}
+BENCHMARK(BM_EvaluateFunction_Aeq);
+
+void BM_EvaluateFunction_beq(benchmark::State& state) {
+    evaluate<functions::beqParams>(state, casadi_functions().beq, {inputs.design_vector.data(), inputs.mass_matrix.data(), inputs.coriolis_matrix.data(), inputs.contact_jacobian.data()});
+}
+BENCHMARK(BM_EvaluateFunction_beq);
+
+void BM_EvaluateFunction_Aineq(benchmark::State& state) {
+    evaluate<functions::AineqParams>(state, casadi_functions().Aineq, {inputs.design_vector.data(), &inputs.friction_coefficient});
+}
+BENCHMARK(BM_EvaluateFunction_Aineq);
+
+void BM_EvaluateFunction_bineq(benchmark::State& state) {
+    evaluate<functions::bineqParams>(state, casadi_functions().bineq, {inputs.design_vector.data(), &inputs.friction_coefficient});
+}
+BENCHMARK(BM_EvaluateFunction_bineq);
+
+void BM_EvaluateFunction_H(benchmark::State& state) {
+    evaluate<functions::HParams>(state, casadi_functions().H, {inputs.design_vector.data(), inputs.desired_taskspace_ddx.data(), inputs.taskspace_jacobian.data(), inputs.taskspace_bias.data(), inputs.weights_vector.data()});
+}
+BENCHMARK(BM_EvaluateFunction_H);
+
+void BM_EvaluateFunction_f(benchmark::State& state) {
+    evaluate<functions::fParams>(state, casadi_functions().f, {inputs.design_vector.data(), inputs.desired_taskspace_ddx.data(), inputs.taskspace_jacobian.data(), inputs.taskspace_bias.data(), inputs.weights_vector.data()});
+}
+BENCHMARK(BM_EvaluateFunction_f);
+
+/* Dense to Sparse Conversion: */
+void BM_SparseView_H(benchmark::State& state) {
+    for(auto _ : state) {
+        Eigen::SparseMatrix<double> sparse_H = inputs.opt_data.H.sparseView();
+        sparse_H.makeCompressed();
+        benchmark::DoNotOptimize(sparse_H.valuePtr());
+    }
+}
+BENCHMARK(BM_SparseView_H);
+
+void BM_SparseView_A(benchmark::State& state) {
+    for(auto _ : state) {
+        Eigen::SparseMatrix<double> sparse_A = inputs.A.sparseView();
+        sparse_A.makeCompressed();
+        benchmark::DoNotOptimize(sparse_A.valuePtr());
+    }
+}
+BENCHMARK(BM_SparseView_A);
+
+/* OSQP: (OperationalSpaceController::update_optimization and solve_optimization) */
+void BM_OsqpUpdate(benchmark::State& state) {
+    for(auto _ : state) {
+        absl::Status result = inputs.solver.UpdateObjectiveAndConstraintMatrices(inputs.sparse_H, inputs.sparse_A);
+        result.Update(inputs.solver.SetObjectiveVector(inputs.opt_data.f));
+        result.Update(inputs.solver.SetBounds(inputs.lb, inputs.ub));
+        if(!result.ok()) {
+            state.SkipWithError(std::string(result.message()));
+            break;
+        }
+    }
+}
+BENCHMARK(BM_OsqpUpdate);
+
+void BM_OsqpSolve_ColdStart(benchmark::State& state) {
+    const OptimizationSolution primal_vector = OptimizationSolution::Zero();
+    const Vector<optimization::constraint_matrix_rows> dual_vector = Vector<optimization::constraint_matrix_rows>::Zero();
+    for(auto _ : state) {
+        state.PauseTiming();
+        std::ignore = inputs.solver.SetWarmStart(primal_vector, dual_vector);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(inputs.solver.Solve());
+    }
+}
+BENCHMARK(BM_OsqpSolve_ColdStart)->Unit(benchmark::kMicrosecond);
+
+void BM_OsqpSolve_WarmStart(benchmark::State& state) {
+    for(auto _ : state) {
+        state.PauseTiming();
+        std::ignore = inputs.solver.SetWarmStart(inputs.solution, inputs.dual_solution);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(inputs.solver.Solve());
+    }
+}
+BENCHMARK(BM_OsqpSolve_WarmStart)->Unit(benchmark::kMicrosecond);
+
+
+int main(int argc, char** argv) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::Create(argv[0], BAZEL_CURRENT_REPOSITORY, &error)
+    );
+    std::filesystem::path xml_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+
+    absl::Status result = set_up_inputs(xml_path);
+    ABSL_CHECK(result.ok()) << result.message();
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    clean_up_inputs();
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <cstdint>
+#include <cstring>
+
+#include "benchmark/benchmark.h"
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+
+#include "Eigen/Dense"
+
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/containers.h"
+#include "operational-space-control/unitree_go2/low_level.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using namespace operational_space_controller::unitree_go2::low_level;
+
+
+/*
+    Low Level Adapter Benchmark: Per tick cost of the Go2 message glue.
+        Decode             : LowState straight into State (LowLevelAdapter::decode, including the CRC check)
+        Decode_Intermediate: LowState through intermediate qpos / qvel vectors as in examples/standing.cc
+        Encode             : Torques and CRC straight into the LowCmd buffer (LowLevelAdapter::encode)
+        Crc_Bitwise        : SDK reference CRC, one polynomial step per bit
+        Crc_Table          : crc32_core, one table lookup per byte
+*/
+// Unitree SDK reference CRC:
+uint32_t crc32_core_bitwise(const uint32_t* data, uint32_t words) {
+    uint32_t crc = 0xFFFFFFFF;
+    for(uint32_t i = 0; i < words; i++) {
+        uint32_t bit = 1u << 31;
+        for(uint32_t b = 0; b < 32; b++) {
+            crc = (crc & 0x80000000) ? (crc << 1) ^ kCrc32Polynomial : crc << 1;
+            if(data[i] & bit)
+                crc ^= kCrc32Polynomial;
+            bit >>= 1;
+        }
+    }
+    return crc;
+}
+
+// Standing keyframe like LowState: (Values only need to be representative)
+LowState make_low_state() {
+    LowState low_state;
+    std::memset(&low_state, 0, sizeof(LowState));
+    constexpr float standing[3] = {0.0f, 0.9f, -1.8f};
+    for(int i = 0; i < kMotors; i++) {
+        low_state.motor_state[i].mode = kServoMode;
+        low_state.motor_state[i].q = standing[i % 3];
+        low_state.motor_state[i].dq = 0.01f * i;
+        low_state.motor_state[i].tau_est = 0.5f * (i % 3);
+    }
+    low_state.imu_state.quaternion[0] = 1.0f;
+    low_state.imu_state.accelerometer[2] = 9.81f;
+    for(int i = 0; i < kFeet; i++)
+        low_state.foot_force[i] = 100;
+    low_state.crc = message_crc(low_state);
+    return low_state;
+}
+
+const LowState low_state = make_low_state();
+
+static void BM_Decode(benchmark::State& benchmark_state) {
+    LowLevelAdapter adapter;
+    State state;
+    for(auto _ : benchmark_state) {
+        absl::Status result = adapter.decode(low_state, state);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(state);
+    }
+}
+BENCHMARK(BM_Decode);
+
+// Hand written glue: Message into qpos / qvel, then sliced into State
+static void BM_Decode_Intermediate(benchmark::State& benchmark_state) {
+    State state;
+    for(auto _ : benchmark_state) {
+        if(crc32_core_bitwise(reinterpret_cast<const uint32_t*>(&low_state), (sizeof(LowState) >> 2) - 1) != low_state.crc)
+            benchmark_state.SkipWithError("CRC mismatch.");
+
+        Vector<model::nq_size> qpos = Vector<model::nq_size>::Zero();
+        Vector<model::nv_size> qvel = Vector<model::nv_size>::Zero();
+        Vector<model::nv_size> qacc = Vector<model::nv_size>::Zero();
+        Vector<model::nv_size> qfrc_actuator = Vector<model::nv_size>::Zero();
+        for(int i = 0; i < 4; i++)
+            qpos(3 + i) = low_state.imu_state.quaternion[i];
+        for(int i = 0; i < 3; i++)
+            qvel(3 + i) = low_state.imu_state.gyroscope[i];
+        for(int i = 0; i < model::nu_size; i++) {
+            qpos(7 + i) = low_state.motor_state[i].q;
+            qvel(6 + i) = low_state.motor_state[i].dq;
+            qacc(6 + i) = low_state.motor_state[i].ddq;
+            qfrc_actuator(6 + i) = low_state.motor_state[i].tau_est;
+        }
+        Vector<3> accelerometer = Eigen::Map<const Vector<3, float>>(low_state.imu_state.accelerometer).cast<double>();
+        Vector<model::contact_site_ids_size> contact_mask;
+        for(int i = 0; i < model::contact_site_ids_size; i++)
+            contact_mask(i) = low_state.foot_force[i] > 20 ? 1.0 : 0.0;
+
+        state.motor_position = qpos(Eigen::seqN(7, model::nu_size));
+        state.motor_velocity = qvel(Eigen::seqN(6, model::nu_size));
+        state.motor_acceleration = qacc(Eigen::seqN(6, model::nu_size));
+        state.torque_estimate = qfrc_actuator(Eigen::seqN(6, model::nu_size));
+        state.body_rotation = qpos(Eigen::seqN(3, 4));
+        state.angular_body_velocity = qvel(Eigen::seqN(3, 3));
+        state.linear_body_acceleration = accelerometer;
+        state.contact_mask = contact_mask;
+        benchmark::DoNotOptimize(state);
+    }
+}
+BENCHMARK(BM_Decode_Intermediate);
+
+static void BM_Encode(benchmark::State& benchmark_state) {
+    LowLevelAdapter adapter;
+    Vector<model::nu_size> torque = Vector<model::nu_size>::LinSpaced(-10.0, 10.0);
+    for(auto _ : benchmark_state) {
+        benchmark::DoNotOptimize(torque);
+        const LowCmd& low_cmd = adapter.encode(torque);
+        benchmark::DoNotOptimize(low_cmd.crc);
+    }
+}
+BENCHMARK(BM_Encode);
+
+static void BM_Crc_Bitwise(benchmark::State& benchmark_state) {
+    for(auto _ : benchmark_state)
+        benchmark::DoNotOptimize(crc32_core_bitwise(reinterpret_cast<const uint32_t*>(&low_state), (sizeof(LowState) >> 2) - 1));
+    benchmark_state.SetBytesProcessed(benchmark_state.iterations() * sizeof(LowState));
+}
+BENCHMARK(BM_Crc_Bitwise);
+
+static void BM_Crc_Table(benchmark::State& benchmark_state) {
+    for(auto _ : benchmark_state)
+        benchmark::DoNotOptimize(message_crc(low_state));
+    benchmark_state.SetBytesProcessed(benchmark_state.iterations() * sizeof(LowState));
+}
+BENCHMARK(BM_Crc_Table);
+
+
+int main(int argc, char** argv) {
+    // Table and reference CRC must agree:
+    ABSL_CHECK(message_crc(low_state) == crc32_core_bitwise(reinterpret_cast<const uint32_t*>(&low_state), (sizeof(LowState) >> 2) - 1))
+        << "CRC table mismatch.";
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,217 @@
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/containers.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/operational_space_controller.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using rules_cc::cc::runfiles::Runfiles;
+using OutputStageGains = OperationalSpaceController::OutputStageGains;
+
+
+/*
+    Output Stage Benchmark: Held QP torque vs the high rate output stage.
+    The QP runs at 500 Hz in simulated time (step(tick_time_ns)) on a 0.25 ms simulation.
+    The torque applied to the simulation is either held between solves or recomputed by the output stage
+    from the current joint state at 2 kHz or 4 kHz. Reports the cost of one output stage evaluation
+    and the closed loop tracking error.
+        Usage: output_stage [duration_s] [stiffness] [damping]
+*/
+enum class Scenario { kStanding, kPushUp };
+
+struct RunResult {
+    std::vector<double> output_us;
+    double position_squared_error = 0.0;
+    double rotation_squared_error = 0.0;
+    double joint_velocity_squared = 0.0;
+    uint64_t ticks = 0;
+    uint64_t outputs = 0;
+    bool fell = false;
+};
+
+int64_t simulation_time_ns(const mjData* mj_data) {
+    return static_cast<int64_t>(std::llround(1e9 * mj_data->time));
+}
+
+// Stamped with the simulation time: (The output stage extrapolates from the state's timestamp)
+State get_state(const mjData* mj_data) {
+    Vector<model::nq_size> qpos = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos);
+    Vector<model::nv_size> qvel = Eigen::Map<Vector<model::nv_size>>(mj_data->qvel);
+    Vector<model::nv_size> qfrc_actuator = Eigen::Map<Vector<model::nv_size>>(mj_data->qfrc_actuator);
+
+    State state;
+    state.motor_position = qpos(Eigen::seqN(7, model::nu_size));
+    state.motor_velocity = qvel(Eigen::seqN(6, model::nu_size));
+    state.motor_acceleration = Vector<model::nu_size>::Zero();
+    state.torque_estimate = qfrc_actuator(Eigen::seqN(6, model::nu_size));
+    state.body_rotation = qpos(Eigen::seqN(3, 4));
+    state.linear_body_velocity = qvel(Eigen::seqN(0, 3));
+    state.angular_body_velocity = qvel(Eigen::seqN(3, 3));
+    state.linear_body_acceleration = Vector<3>::Zero();
+    state.contact_mask = Vector<model::contact_site_ids_size>::Constant(1.0);
+    state.timestamp_ns = simulation_time_ns(mj_data);
+    return state;
+}
+
+// output_period_us: 0 holds the QP torque between solves
+RunResult run(
+    Scenario scenario,
+    int output_period_us,
+    const OutputStageGains& gains,
+    double duration,
+    const std::filesystem::path& osc_model_path,
+    const mjModel* mj_model
+) {
+    mjData* mj_data = mj_makeData(mj_model);
+    mj_resetDataKeyframe(mj_model, mj_data, 0);
+    mj_forward(mj_model, mj_data);
+    const Vector<3> nominal_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+
+    OperationalSpaceController controller(osc_model_path);
+    absl::Status result = controller.initialize(get_state(mj_data));
+    result.Update(controller.initialize_optimization());
+    if(output_period_us > 0)
+        result.Update(controller.enable_output_stage(gains));
+    ABSL_CHECK(result.ok()) << result.message();
+
+    const double timestep_us = 1e6 * mj_model->opt.timestep;
+    const int qp_decimation = std::max(1, static_cast<int>(std::round(2000.0 / timestep_us)));
+    const int output_decimation = output_period_us > 0 ? std::max(1, static_cast<int>(std::round(output_period_us / timestep_us))) : qp_decimation;
+    Vector<model::nu_size> torque_command = Vector<model::nu_size>::Zero();
+    uint64_t simulation_steps = 0;
+
+    RunResult run_result;
+    while(mj_data->time < duration) {
+        const State state = get_state(mj_data);
+        const int64_t time_ns = simulation_time_ns(mj_data);
+
+        if(simulation_steps % qp_decimation == 0) {
+            const double time = mj_data->time;
+            Vector<3> body_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+
+            // Scenario Targets: (Same as scenario_runner)
+            Vector<3> position_target = nominal_position;
+            Vector<3> velocity_target = Vector<3>::Zero();
+            if(scenario == Scenario::kPushUp) {
+                const double amplitude = 0.1;
+                const double frequency = 0.5;
+                position_target(2) += amplitude * std::sin(2.0 * M_PI * frequency * time);
+                velocity_target(2) = 2.0 * M_PI * amplitude * frequency * std::cos(2.0 * M_PI * frequency * time);
+            }
+            Eigen::Quaternion<double> body_rotation = Eigen::Quaternion<double>(state.body_rotation(0), state.body_rotation(1), state.body_rotation(2), state.body_rotation(3));
+            Vector<3> position_error = position_target - body_position;
+            Vector<3> velocity_error = velocity_target - state.linear_body_velocity;
+            Vector<3> rotation_error = (Eigen::Quaternion<double>(1, 0, 0, 0) * body_rotation.conjugate()).vec();
+            Vector<3> angular_velocity_error = Vector<3>::Zero() - state.angular_body_velocity;
+            Vector<3> linear_control = 150.0 * (position_error) + 25.0 * (velocity_error);
+            Vector<3> angular_control = 50.0 * (rotation_error) + 10.0 * (angular_velocity_error);
+            TaskspaceTargets taskspace_targets = TaskspaceTargets::Zero();
+            taskspace_targets.row(0) << linear_control.transpose(), angular_control.transpose();
+
+            controller.update_state(state);
+            controller.update_taskspace_targets(taskspace_targets);
+            result.Update(controller.step(time_ns));
+            torque_command = controller.get_torque_command();
+
+            run_result.position_squared_error += position_error.squaredNorm();
+            run_result.rotation_squared_error += rotation_error.squaredNorm();
+            run_result.ticks++;
+        }
+
+        // Output Stage: (Fresh joint state at the output rate)
+        if(output_period_us > 0 && simulation_steps % output_decimation == 0) {
+            auto start = std::chrono::steady_clock::now();
+            torque_command = controller.get_torque_command(state, time_ns);
+            run_result.output_us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            run_result.outputs++;
+        }
+        run_result.joint_velocity_squared += state.motor_velocity.squaredNorm();
+
+        mju_copy(mj_data->ctrl, torque_command.data(), model::nu_size);
+        mj_step(mj_model, mj_data);
+        simulation_steps++;
+
+        if(mj_data->qpos[2] < 0.5 * nominal_position(2)) {
+            run_result.fell = true;
+            break;
+        }
+    }
+    ABSL_CHECK(result.ok()) << result.message();
+    run_result.joint_velocity_squared /= std::max<uint64_t>(simulation_steps, 1);
+
+    result.Update(controller.clean_up());
+    ABSL_CHECK(result.ok()) << result.message();
+    mj_deleteData(mj_data);
+    return run_result;
+}
+
+double percentile(std::vector<double> samples, double p) {
+    if(samples.empty())
+        return 0.0;
+    std::sort(samples.begin(), samples.end());
+    size_t index = std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()));
+    return samples[index];
+}
+
+void report(const std::string& name, int output_period_us, const RunResult& run_result) {
+    const double ticks = std::max<uint64_t>(run_result.ticks, 1);
+    const std::string output = output_period_us > 0 ? std::to_string(1000000 / output_period_us) + " Hz output stage" : "held QP torque";
+    std::cout << name << " | " << output << (run_result.fell ? " | FELL" : "") << std::endl;
+    if(output_period_us > 0)
+        std::cout << "  Output stage (us):         p50 " << percentile(run_result.output_us, 0.5)
+            << " | p99 " << percentile(run_result.output_us, 0.99) << " | calls " << run_result.outputs << std::endl;
+    std::cout << "  Base position RMS error:   " << std::sqrt(run_result.position_squared_error / ticks) << std::endl;
+    std::cout << "  Base rotation RMS error:   " << std::sqrt(run_result.rotation_squared_error / ticks) << std::endl;
+    std::cout << "  Joint velocity RMS:        " << std::sqrt(run_result.joint_velocity_squared) << std::endl;
+}
+
+
+int main(int argc, char** argv) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::Create(argv[0], BAZEL_CURRENT_REPOSITORY, &error)
+    );
+    std::filesystem::path osc_model_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+    std::filesystem::path simulation_model_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/scene_go2.xml");
+
+    const double duration = argc > 1 ? std::atof(argv[1]) : 10.0;
+    const double stiffness = argc > 2 ? std::atof(argv[2]) : 20.0;
+    const double damping = argc > 3 ? std::atof(argv[3]) : 1.0;
+    const OutputStageGains gains = OutputStageGains::uniform(stiffness, damping);
+
+    char mj_error[1000];
+    mjModel* mj_model = mj_loadXML(simulation_model_path.c_str(), nullptr, mj_error, 1000);
+    ABSL_CHECK(mj_model) << mj_error;
+    // Fine simulation step so the output stage rates are resolved:
+    mj_model->opt.timestep = 0.00025;
+
+    bool fell = false;
+    for(auto [scenario, name] : {std::pair{Scenario::kStanding, "standing"}, std::pair{Scenario::kPushUp, "push_up"}}) {
+        for(int output_period_us : {0, 500, 250}) {
+            RunResult run_result = run(scenario, output_period_us, gains, duration, osc_model_path, mj_model);
+            report(name, output_period_us, run_result);
+            fell |= run_result.fell;
+        }
+    }
+
+    mj_deleteModel(mj_model);
+    return fell ? 2 : 0;
+}
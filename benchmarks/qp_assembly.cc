@@ -0,0 +1,113 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "Eigen/Dense"
+
+#include "operational-space-control/utilities.h"
+#include "operational-space-control/function_utilities.h"
+#include "operational-space-control/isa_dispatch.h"
+#include "operational-space-control/qp_assembly.h"
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/containers.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using functions = Descriptor::functions;
+
+// Generated functions of the active ISA variant: (Same table as OperationalSpaceController)
+const FunctionTable<double>& casadi_functions() {
+    return functions::isa_variants[static_cast<int>(operational_space_controller::isa_dispatch::active_variant())];
+}
+
+
+// Casadi generated QP assembly: (Same path as OperationalSpaceController::update_optimization_data)
+void casadi_assembly(
+    const OSCData& osc_data,
+    const TaskspaceTargets& taskspace_targets,
+    const OptimizationSolution& design_vector,
+    const Weights& weights,
+    double friction_coefficient,
+    OptimizationData& opt_data
+) {
+    OptimizationSolution q = design_vector;
+    Vector<optimization::weights_size> weights_vector;
+    weights_vector << weights.task, weights.torque, weights.regularization;
+    auto mass_matrix = matrix_utils::transformMatrix<double, model::nv_size, model::nv_size, matrix_utils::ColumnMajor>(osc_data.mass_matrix.data());
+    auto coriolis_matrix = matrix_utils::transformMatrix<double, model::nv_size, 1, matrix_utils::ColumnMajor>(osc_data.coriolis_matrix.data());
+    auto contact_jacobian = matrix_utils::transformMatrix<double, model::nv_size, optimization::z_size, matrix_utils::ColumnMajor>(osc_data.contact_jacobian.data());
+    auto taskspace_jacobian = matrix_utils::transformMatrix<double, optimization::s_size, model::nv_size, matrix_utils::ColumnMajor>(osc_data.taskspace_jacobian.data());
+    auto taskspace_bias = matrix_utils::transformMatrix<double, optimization::s_size, 1, matrix_utils::ColumnMajor>(osc_data.taskspace_bias.data());
+    auto desired_taskspace_ddx = matrix_utils::transformMatrix<double, model::site_ids_size, 6, matrix_utils::ColumnMajor>(taskspace_targets.data());
+
+    opt_data.Aeq = evaluate_function<functions::AeqParams>(casadi_functions().Aeq, {q.data(), mass_matrix.data(), coriolis_matrix.data(), contact_jacobian.data()});
+    opt_data.beq = evaluate_function<functions::beqParams>(casadi_functions().beq, {q.data(), mass_matrix.data(), coriolis_matrix.data(), contact_jacobian.data()});
+    opt_data.Aineq = evaluate_function<functions::AineqParams>(casadi_functions().Aineq, {q.data(), &friction_coefficient});
+    opt_data.bineq = evaluate_function<functions::bineqParams>(casadi_functions().bineq, {q.data(), &friction_coefficient});
+    opt_data.H = evaluate_function<functions::HParams>(casadi_functions().H, {q.data(), desired_taskspace_ddx.data(), taskspace_jacobian.data(), taskspace_bias.data(), weights_vector.data()});
+    opt_data.f = evaluate_function<functions::fParams>(casadi_functions().f, {q.data(), desired_taskspace_ddx.data(), taskspace_jacobian.data(), taskspace_bias.data(), weights_vector.data()});
+}
+
+template <typename Function>
+double time_per_call_us(Function&& function, int iterations) {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    for(int i = 0; i < iterations; i++)
+        function();
+    auto end = Clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 100000;
+
+    // Fixed pseudo-random inputs: (Symmetric positive definite mass matrix)
+    std::srand(0);
+    OSCData osc_data;
+    Matrix<model::nv_size, model::nv_size> L = Matrix<model::nv_size, model::nv_size>::Random();
+    osc_data.mass_matrix = L * L.transpose() + Matrix<model::nv_size, model::nv_size>::Identity();
+    osc_data.coriolis_matrix = Vector<model::nv_size>::Random();
+    osc_data.contact_jacobian = Matrix<model::nv_size, optimization::z_size>::Random();
+    osc_data.taskspace_jacobian = Matrix<optimization::s_size, model::nv_size>::Random();
+    osc_data.taskspace_bias = Vector<optimization::s_size>::Random();
+    TaskspaceTargets taskspace_targets = TaskspaceTargets::Random();
+    OptimizationSolution design_vector = OptimizationSolution::Random();
+    Weights weights = Weights::defaults();
+    double friction_coefficient = optimization::friction_coefficient;
+
+    // Assemble with both backends:
+    OptimizationData casadi_data;
+    OptimizationData native_data;
+    operational_space_controller::qp_assembly::StructuredAssembly<Descriptor> structured_assembly;
+    structured_assembly.initialize(weights, friction_coefficient, native_data);
+    casadi_assembly(osc_data, taskspace_targets, design_vector, weights, friction_coefficient, casadi_data);
+    structured_assembly.update(osc_data, taskspace_targets, design_vector, native_data);
+
+    // Compare: (Structured assembly only writes the upper triangle of H)
+    MatrixColMajor<optimization::H_rows, optimization::H_cols> H_casadi = casadi_data.H.triangularView<Eigen::Upper>();
+    MatrixColMajor<optimization::H_rows, optimization::H_cols> H_native = native_data.H.triangularView<Eigen::Upper>();
+    std::cout << "Max absolute difference (Casadi vs Structured):" << std::endl;
+    std::cout << "  Aeq:   " << (casadi_data.Aeq - native_data.Aeq).cwiseAbs().maxCoeff() << std::endl;
+    std::cout << "  beq:   " << (casadi_data.beq - native_data.beq).cwiseAbs().maxCoeff() << std::endl;
+    std::cout << "  Aineq: " << (casadi_data.Aineq - native_data.Aineq).cwiseAbs().maxCoeff() << std::endl;
+    std::cout << "  bineq: " << (casadi_data.bineq - native_data.bineq).cwiseAbs().maxCoeff() << std::endl;
+    std::cout << "  H:     " << (H_casadi - H_native).cwiseAbs().maxCoeff() << std::endl;
+    std::cout << "  f:     " << (casadi_data.f - native_data.f).cwiseAbs().maxCoeff() << std::endl;
+
+    // Timing:
+    double casadi_us = time_per_call_us([&]() {
+        casadi_assembly(osc_data, taskspace_targets, design_vector, weights, friction_coefficient, casadi_data);
+    }, iterations);
+    double native_us = time_per_call_us([&]() {
+        structured_assembly.update(osc_data, taskspace_targets, design_vector, native_data);
+    }, iterations);
+
+    std::cout << "QP Assembly (" << iterations << " iterations):" << std::endl;
+    std::cout << "  Casadi:     " << casadi_us << " us" << std::endl;
+    std::cout << "  Structured: " << native_us << " us" << std::endl;
+    std::cout << "  Speedup:    " << casadi_us / native_us << "x" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/containers.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/operational_space_controller.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using rules_cc::cc::runfiles::Runfiles;
+using RacingSettings = OperationalSpaceController::RacingSettings;
+
+
+/*
+    Racing Solver Benchmark: Solver stage latency with a single OSQP instance vs two racing instances.
+    The Go2 stands under random base pushes at 500 Hz in simulated time (step(tick_time_ns)), so the QPs
+    include the hard solves after every push. Reports the solver stage distribution, the tail latency saved
+    relative to the single instance and how often each racing instance won.
+        Usage: racing_solver [duration_s] [secondary_cpu]
+*/
+struct Configuration {
+    std::string name;
+    bool racing;
+    RacingSettings racing_settings;
+};
+
+struct RunResult {
+    std::vector<double> solver_stage_us;
+    uint64_t primary_race_wins = 0;
+    uint64_t secondary_race_wins = 0;
+    uint64_t skipped_races = 0;
+    double max_race_blocked_us = 0.0;
+    uint64_t solver_failures = 0;
+    bool fell = false;
+};
+
+State get_state(const mjData* mj_data) {
+    Vector<model::nq_size> qpos = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos);
+    Vector<model::nv_size> qvel = Eigen::Map<Vector<model::nv_size>>(mj_data->qvel);
+    Vector<model::nv_size> qfrc_actuator = Eigen::Map<Vector<model::nv_size>>(mj_data->qfrc_actuator);
+
+    State state;
+    state.motor_position = qpos(Eigen::seqN(7, model::nu_size));
+    state.motor_velocity = qvel(Eigen::seqN(6, model::nu_size));
+    state.motor_acceleration = Vector<model::nu_size>::Zero();
+    state.torque_estimate = qfrc_actuator(Eigen::seqN(6, model::nu_size));
+    state.body_rotation = qpos(Eigen::seqN(3, 4));
+    state.linear_body_velocity = qvel(Eigen::seqN(0, 3));
+    state.angular_body_velocity = qvel(Eigen::seqN(3, 3));
+    state.linear_body_acceleration = Vector<3>::Zero();
+    state.contact_mask = Vector<model::contact_site_ids_size>::Constant(1.0);
+    return state;
+}
+
+RunResult run(
+    const Configuration& configuration,
+    double duration,
+    const std::filesystem::path& osc_model_path,
+    const mjModel* mj_model
+) {
+    mjData* mj_data = mj_makeData(mj_model);
+    mj_resetDataKeyframe(mj_model, mj_data, 0);
+    mj_forward(mj_model, mj_data);
+    const Vector<3> nominal_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+    const int base_body = mj_name2id(mj_model, mjOBJ_BODY, "base_link");
+    ABSL_CHECK(base_body >= 0) << "base_link not found.";
+
+    OperationalSpaceController controller(osc_model_path);
+    absl::Status result = controller.initialize(get_state(mj_data));
+    result.Update(controller.initialize_optimization());
+    if(configuration.racing)
+        result.Update(controller.enable_racing_solver(configuration.racing_settings));
+    ABSL_CHECK(result.ok()) << result.message();
+
+    // Same pushes for every configuration: (0.1 s every 0.5 s, random horizontal direction)
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> direction(0.0, 2.0 * M_PI);
+    const double push_force = 60.0;
+    Vector<2> push = Vector<2>::Zero();
+
+    const int qp_decimation = std::max(1, static_cast<int>(std::round(0.002 / mj_model->opt.timestep)));
+    Vector<model::nu_size> torque_command = Vector<model::nu_size>::Zero();
+    uint64_t simulation_steps = 0;
+
+    RunResult run_result;
+    run_result.solver_stage_us.reserve(static_cast<size_t>(duration / 0.002) + 1);
+    while(mj_data->time < duration) {
+        const double push_phase = std::fmod(mj_data->time, 0.5);
+        if(push_phase < mj_model->opt.timestep) {
+            const double angle = direction(generator);
+            push << push_force * std::cos(angle), push_force * std::sin(angle);
+        }
+        mj_data->xfrc_applied[6 * base_body + 0] = push_phase < 0.1 ? push(0) : 0.0;
+        mj_data->xfrc_applied[6 * base_body + 1] = push_phase < 0.1 ? push(1) : 0.0;
+
+        if(simulation_steps % qp_decimation == 0) {
+            const State state = get_state(mj_data);
+            Vector<3> body_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+
+            // Standing Targets: (Same gains as scenario_runner)
+            Eigen::Quaternion<double> body_rotation = Eigen::Quaternion<double>(state.body_rotation(0), state.body_rotation(1), state.body_rotation(2), state.body_rotation(3));
+            Vector<3> position_error = nominal_position - body_position;
+            Vector<3> velocity_error = Vector<3>::Zero() - state.linear_body_velocity;
+            Vector<3> rotation_error = (Eigen::Quaternion<double>(1, 0, 0, 0) * body_rotation.conjugate()).vec();
+            Vector<3> angular_velocity_error = Vector<3>::Zero() - state.angular_body_velocity;
+            Vector<3> linear_control = 150.0 * (position_error) + 25.0 * (velocity_error);
+            Vector<3> angular_control = 50.0 * (rotation_error) + 10.0 * (angular_velocity_error);
+            TaskspaceTargets taskspace_targets = TaskspaceTargets::Zero();
+            taskspace_targets.row(0) << linear_control.transpose(), angular_control.transpose();
+
+            controller.update_state(state);
+            controller.update_taskspace_targets(taskspace_targets);
+            result.Update(controller.step(static_cast<int64_t>(std::llround(1e9 * mj_data->time))));
+            torque_command = controller.get_torque_command();
+            run_result.solver_stage_us.push_back(controller.get_statistics().solver_stage_us);
+        }
+
+        mju_copy(mj_data->ctrl, torque_command.data(), model::nu_size);
+        mj_step(mj_model, mj_data);
+        simulation_steps++;
+
+        if(mj_data->qpos[2] < 0.5 * nominal_position(2)) {
+            run_result.fell = true;
+            break;
+        }
+    }
+    ABSL_CHECK(result.ok()) << result.message();
+
+    const auto statistics = controller.get_statistics();
+    run_result.primary_race_wins = statistics.primary_race_wins;
+    run_result.secondary_race_wins = statistics.secondary_race_wins;
+    run_result.skipped_races = statistics.skipped_races;
+    run_result.max_race_blocked_us = statistics.max_race_blocked_us;
+    run_result.solver_failures = statistics.solver_failures;
+
+    result.Update(controller.clean_up());
+    ABSL_CHECK(result.ok()) << result.message();
+    mj_deleteData(mj_data);
+    return run_result;
+}
+
+double percentile(std::vector<double> samples, double p) {
+    if(samples.empty())
+        return 0.0;
+    std::sort(samples.begin(), samples.end());
+    size_t index = std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()));
+    return samples[index];
+}
+
+
+int main(int argc, char** argv) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::Create(argv[0], BAZEL_CURRENT_REPOSITORY, &error)
+    );
+    std::filesystem::path osc_model_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+    std::filesystem::path simulation_model_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/scene_go2.xml");
+
+    const double duration = argc > 1 ? std::atof(argv[1]) : 10.0;
+    const int secondary_cpu = argc > 2 ? std::atoi(argv[2]) : -1;
+
+    char mj_error[1000];
+    mjModel* mj_model = mj_loadXML(simulation_model_path.c_str(), nullptr, mj_error, 1000);
+    ABSL_CHECK(mj_model) << mj_error;
+
+    // Racing Configurations: (Warm started primary against a cold started secondary, with default or stiffer rho)
+    RacingSettings cold_start;
+    cold_start.cpu = secondary_cpu;
+    RacingSettings cold_start_rho = cold_start;
+    cold_start_rho.secondary_settings.rho = 10.0 * cold_start.secondary_settings.rho;
+    const std::vector<Configuration> configurations = {
+        {"single", false, RacingSettings()},
+        {"racing_cold", true, cold_start},
+        {"racing_cold_rho", true, cold_start_rho},
+    };
+
+    std::cout << "Solver stage latency (us) under base pushes, " << duration << "s at 500 Hz:" << std::endl;
+    std::cout << std::setw(16) << "solver" << std::setw(10) << "p50" << std::setw(10) << "p99"
+        << std::setw(10) << "p99.9" << std::setw(10) << "max" << std::setw(14) << "p99.9 saved"
+        << std::setw(10) << "primary" << std::setw(11) << "secondary" << std::setw(10) << "skipped"
+        << std::setw(14) << "max blocked" << std::setw(10) << "failures" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    bool fell = false;
+    double baseline_tail_us = 0.0;
+    for(const Configuration& configuration : configurations) {
+        RunResult run_result = run(configuration, duration, osc_model_path, mj_model);
+        const double tail_us = percentile(run_result.solver_stage_us, 0.999);
+        if(!configuration.racing)
+            baseline_tail_us = tail_us;
+        std::cout << std::setw(16) << configuration.name
+            << std::setw(10) << percentile(run_result.solver_stage_us, 0.5)
+            << std::setw(10) << percentile(run_result.solver_stage_us, 0.99)
+            << std::setw(10) << tail_us
+            << std::setw(10) << percentile(run_result.solver_stage_us, 1.0)
+            << std::setw(14) << baseline_tail_us - tail_us
+            << std::setw(10) << run_result.primary_race_wins
+            << std::setw(11) << run_result.secondary_race_wins
+            << std::setw(10) << run_result.skipped_races
+            << std::setw(14) << run_result.max_race_blocked_us
+            << std::setw(10) << run_result.solver_failures
+            << (run_result.fell ? "  FELL" : "") << std::endl;
+        fell |= run_result.fell;
+    }
+
+    mj_deleteModel(mj_model);
+    return fell ? 2 : 0;
+}
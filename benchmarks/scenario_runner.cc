@@ -0,0 +1,289 @@
+#include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/containers.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/operational_space_controller.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using rules_cc::cc::runfiles::Runfiles;
+
+
+/*
+    Headless Scenario Runner: Runs independent MuJoCo + OSC episodes in simulated time across all cores.
+    The controller is stepped synchronously (OperationalSpaceController::step) every control period.
+        Usage: scenario_runner [scenario] [episodes] [duration_s] [threads]
+        Scenarios:
+            standing     : Hold the keyframe base pose.
+            push_up      : Sinusoidal base height tracking.
+            perturbation : Standing with random horizontal pushes on the base.
+            randomized   : Standing from randomized initial base pose, joint positions and velocities.
+*/
+enum class Scenario { kStanding, kPushUp, kPerturbation, kRandomized };
+
+struct RunnerConfig {
+    Scenario scenario = Scenario::kStanding;
+    int episodes = 64;
+    double duration = 10.0;
+    int threads = 0;
+    int control_rate_us = 2000;
+    unsigned int seed = 0;
+};
+
+struct EpisodeResult {
+    double position_rms_error = 0.0;
+    double rotation_rms_error = 0.0;
+    uint64_t simulation_steps = 0;
+    uint64_t ticks = 0;
+    uint64_t solver_failures = 0;
+    bool fell = false;
+};
+
+bool parse_scenario(const std::string& name, Scenario& scenario) {
+    if(name == "standing") scenario = Scenario::kStanding;
+    else if(name == "push_up") scenario = Scenario::kPushUp;
+    else if(name == "perturbation") scenario = Scenario::kPerturbation;
+    else if(name == "randomized") scenario = Scenario::kRandomized;
+    else return false;
+    return true;
+}
+
+State get_state(const mjData* mj_data) {
+    Vector<model::nq_size> qpos = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos);
+    Vector<model::nv_size> qvel = Eigen::Map<Vector<model::nv_size>>(mj_data->qvel);
+    Vector<model::nv_size> qfrc_actuator = Eigen::Map<Vector<model::nv_size>>(mj_data->qfrc_actuator);
+
+    State state;
+    state.motor_position = qpos(Eigen::seqN(7, model::nu_size));
+    state.motor_velocity = qvel(Eigen::seqN(6, model::nu_size));
+    state.motor_acceleration = Vector<model::nu_size>::Zero();
+    state.torque_estimate = qfrc_actuator(Eigen::seqN(6, model::nu_size));
+    state.body_rotation = qpos(Eigen::seqN(3, 4));
+    state.linear_body_velocity = qvel(Eigen::seqN(0, 3));
+    state.angular_body_velocity = qvel(Eigen::seqN(3, 3));
+    state.linear_body_acceleration = Vector<3>::Zero();
+    state.contact_mask = Vector<model::contact_site_ids_size>::Constant(1.0);
+    return state;
+}
+
+EpisodeResult run_episode(
+    const RunnerConfig& config,
+    const OperationalSpaceController::SharedModel& osc_model,
+    const mjModel* mj_model,
+    int episode
+) {
+    std::mt19937 generator(config.seed + episode);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+    mjData* mj_data = mj_makeData(mj_model);
+    mj_resetDataKeyframe(mj_model, mj_data, 0);
+    const Vector<3> nominal_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+
+    // Randomized Initial State:
+    if(config.scenario == Scenario::kRandomized) {
+        mj_data->qpos[2] += 0.03 * uniform(generator);
+        Eigen::Quaternion<double> rotation =
+            Eigen::AngleAxis<double>(0.1 * uniform(generator), Eigen::Vector3d::UnitX()) *
+            Eigen::AngleAxis<double>(0.1 * uniform(generator), Eigen::Vector3d::UnitY());
+        mj_data->qpos[3] = rotation.w();
+        mj_data->qpos[4] = rotation.x();
+        mj_data->qpos[5] = rotation.y();
+        mj_data->qpos[6] = rotation.z();
+        for(int i = 0; i < model::nu_size; i++)
+            mj_data->qpos[7 + i] += 0.1 * uniform(generator);
+        for(int i = 0; i < 6; i++)
+            mj_data->qvel[i] = 0.2 * uniform(generator);
+    }
+    mj_forward(mj_model, mj_data);
+
+    // Controllers share one model: (Loaded once in main)
+    OperationalSpaceController controller(osc_model, config.control_rate_us);
+    absl::Status result;
+    result.Update(controller.initialize(get_state(mj_data)));
+    result.Update(controller.initialize_optimization());
+    ABSL_CHECK(result.ok()) << result.message();
+
+    const int base_body_id = mj_model->jnt_bodyid[0];
+    const double control_period = config.control_rate_us * 1e-6;
+    const int decimation = std::max(1, static_cast<int>(std::round(control_period / mj_model->opt.timestep)));
+    Vector<model::nu_size> torque_command = Vector<model::nu_size>::Zero();
+    double position_squared_error = 0.0;
+    double rotation_squared_error = 0.0;
+    double next_push_time = 0.5;
+    double push_end_time = 0.0;
+
+    EpisodeResult episode_result;
+    while(mj_data->time < config.duration) {
+        const double time = mj_data->time;
+        Vector<3> body_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+
+        if(episode_result.simulation_steps % decimation == 0) {
+            State state = get_state(mj_data);
+            controller.update_state(state);
+
+            // Scenario Targets:
+            Vector<3> position_target = nominal_position;
+            Vector<3> velocity_target = Vector<3>::Zero();
+            if(config.scenario == Scenario::kPushUp) {
+                const double amplitude = 0.1;
+                const double frequency = 0.5;
+                position_target(2) += amplitude * std::sin(2.0 * M_PI * frequency * time);
+                velocity_target(2) = 2.0 * M_PI * amplitude * frequency * std::cos(2.0 * M_PI * frequency * time);
+            }
+            Eigen::Quaternion<double> body_rotation = Eigen::Quaternion<double>(state.body_rotation(0), state.body_rotation(1), state.body_rotation(2), state.body_rotation(3));
+            Vector<3> position_error = position_target - body_position;
+            Vector<3> velocity_error = velocity_target - state.linear_body_velocity;
+            Vector<3> rotation_error = (Eigen::Quaternion<double>(1, 0, 0, 0) * body_rotation.conjugate()).vec();
+            Vector<3> angular_velocity_error = Vector<3>::Zero() - state.angular_body_velocity;
+            Vector<3> linear_control = 150.0 * (position_error) + 25.0 * (velocity_error);
+            Vector<3> angular_control = 50.0 * (rotation_error) + 10.0 * (angular_velocity_error);
+            TaskspaceTargets taskspace_targets = TaskspaceTargets::Zero();
+            taskspace_targets.row(0) << linear_control.transpose(), angular_control.transpose();
+            controller.update_taskspace_targets(taskspace_targets);
+
+            result.Update(controller.step());
+            torque_command = controller.get_torque_command();
+
+            position_squared_error += position_error.squaredNorm();
+            rotation_squared_error += rotation_error.squaredNorm();
+        }
+
+        // Perturbation Pushes: (Random horizontal force on the base for 0.1s every second)
+        if(config.scenario == Scenario::kPerturbation) {
+            if(time >= next_push_time) {
+                const double angle = M_PI * uniform(generator);
+                const double magnitude = 45.0 + 15.0 * uniform(generator);
+                mj_data->xfrc_applied[6 * base_body_id + 0] = magnitude * std::cos(angle);
+                mj_data->xfrc_applied[6 * base_body_id + 1] = magnitude * std::sin(angle);
+                push_end_time = time + 0.1;
+                next_push_time += 1.0;
+            }
+            else if(time >= push_end_time) {
+                mju_zero(mj_data->xfrc_applied + 6 * base_body_id, 6);
+            }
+        }
+
+        mju_copy(mj_data->ctrl, torque_command.data(), model::nu_size);
+        mj_step(mj_model, mj_data);
+        episode_result.simulation_steps++;
+
+        // Fall Detection:
+        if(mj_data->qpos[2] < 0.5 * nominal_position(2)) {
+            episode_result.fell = true;
+            break;
+        }
+    }
+    ABSL_CHECK(result.ok()) << result.message();
+
+    auto statistics = controller.get_statistics();
+    episode_result.ticks = statistics.ticks;
+    episode_result.solver_failures = statistics.solver_failures;
+    if(statistics.ticks > 0) {
+        episode_result.position_rms_error = std::sqrt(position_squared_error / statistics.ticks);
+        episode_result.rotation_rms_error = std::sqrt(rotation_squared_error / statistics.ticks);
+    }
+
+    result.Update(controller.clean_up());
+    ABSL_CHECK(result.ok()) << result.message();
+    mj_deleteData(mj_data);
+    return episode_result;
+}
+
+
+int main(int argc, char** argv) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::Create(argv[0], BAZEL_CURRENT_REPOSITORY, &error)
+    );
+    std::filesystem::path osc_model_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+    std::filesystem::path simulation_model_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/scene_go2.xml");
+
+    RunnerConfig config;
+    if(argc > 1 && !parse_scenario(argv[1], config.scenario)) {
+        std::cerr << "Unknown scenario: " << argv[1] << " (standing, push_up, perturbation, randomized)" << std::endl;
+        return 1;
+    }
+    if(argc > 2) config.episodes = std::atoi(argv[2]);
+    if(argc > 3) config.duration = std::atof(argv[3]);
+    config.threads = argc > 4 ? std::atoi(argv[4]) : static_cast<int>(std::thread::hardware_concurrency());
+    config.threads = std::max(1, std::min(config.threads, config.episodes));
+
+    // Simulation and controller models are shared read only by all episodes:
+    char mj_error[1000];
+    mjModel* mj_model = mj_loadXML(simulation_model_path.c_str(), nullptr, mj_error, 1000);
+    ABSL_CHECK(mj_model) << mj_error;
+    auto osc_model = OperationalSpaceController::ControllerModel::load(osc_model_path);
+    ABSL_CHECK(osc_model.ok()) << osc_model.status().message();
+
+    std::vector<EpisodeResult> results(config.episodes);
+    std::atomic<int> next_episode{0};
+    auto start_time = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for(int i = 0; i < config.threads; i++) {
+        workers.emplace_back([&]() {
+            for(int episode = next_episode++; episode < config.episodes; episode = next_episode++)
+                results[episode] = run_episode(config, *osc_model, mj_model, episode);
+        });
+    }
+    for(std::thread& worker : workers)
+        worker.join();
+    double wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    // Aggregate:
+    uint64_t simulation_steps = 0;
+    uint64_t ticks = 0;
+    uint64_t solver_failures = 0;
+    int falls = 0;
+    double mean_position_error = 0.0;
+    double max_position_error = 0.0;
+    double mean_rotation_error = 0.0;
+    double max_rotation_error = 0.0;
+    for(const EpisodeResult& result : results) {
+        simulation_steps += result.simulation_steps;
+        ticks += result.ticks;
+        solver_failures += result.solver_failures;
+        falls += result.fell;
+        mean_position_error += result.position_rms_error / config.episodes;
+        mean_rotation_error += result.rotation_rms_error / config.episodes;
+        max_position_error = std::max(max_position_error, result.position_rms_error);
+        max_rotation_error = std::max(max_rotation_error, result.rotation_rms_error);
+    }
+
+    std::cout << "Scenario: " << (argc > 1 ? argv[1] : "standing")
+        << " | Episodes: " << config.episodes << " | Duration: " << config.duration << "s"
+        << " | Threads: " << config.threads
+        << " | ISA: " << operational_space_controller::isa_dispatch::name(operational_space_controller::isa_dispatch::active_variant()) << std::endl;
+    std::cout << "  Base position RMS error (m):   mean " << mean_position_error << " | max " << max_position_error << std::endl;
+    std::cout << "  Base rotation RMS error:       mean " << mean_rotation_error << " | max " << max_rotation_error << std::endl;
+    std::cout << "  Falls:                         " << falls << std::endl;
+    std::cout << "  Solver failures:               " << solver_failures << " / " << ticks << " ticks" << std::endl;
+    std::cout << "  Simulated steps/s:             " << simulation_steps / wall_time << std::endl;
+    std::cout << "  Real time factor (aggregate):  " << simulation_steps * mj_model->opt.timestep / wall_time << std::endl;
+    std::cout << "  Wall time:                     " << wall_time << "s" << std::endl;
+
+    mj_deleteModel(mj_model);
+
+    // Nonzero exit code for regression scripts:
+    return falls > 0 ? 2 : 0;
+}
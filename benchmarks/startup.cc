@@ -0,0 +1,146 @@
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/containers.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/operational_space_controller.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using rules_cc::cc::runfiles::Runfiles;
+using ControllerModel = OperationalSpaceController::ControllerModel;
+
+
+/*
+    Startup Benchmark: Controller initialization time per model source.
+        xml          : Parses the MJCF XML and resolves ids in every controller (cold start)
+        mjb          : Loads a precompiled MJB file in every controller
+        mjb buffer   : Loads a precompiled MJB from memory in every controller
+        shared model : Controllers share one loaded model (warm start)
+    Each sample is a fresh controller: initialize() and initialize_optimization() are timed separately.
+        Usage: startup [iterations]
+*/
+struct StartupTimes {
+    std::vector<double> model_us;
+    std::vector<double> initialize_us;
+    std::vector<double> optimization_us;
+};
+
+State keyframe_state(const mjModel* mj_model) {
+    mjData* mj_data = mj_makeData(mj_model);
+    mj_resetDataKeyframe(mj_model, mj_data, 0);
+    Vector<model::nq_size> qpos = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos);
+
+    State state;
+    state.motor_position = qpos(Eigen::seqN(7, model::nu_size));
+    state.motor_velocity = Vector<model::nu_size>::Zero();
+    state.motor_acceleration = Vector<model::nu_size>::Zero();
+    state.torque_estimate = Vector<model::nu_size>::Zero();
+    state.body_rotation = qpos(Eigen::seqN(3, 4));
+    state.linear_body_velocity = Vector<3>::Zero();
+    state.angular_body_velocity = Vector<3>::Zero();
+    state.linear_body_acceleration = Vector<3>::Zero();
+    state.contact_mask = Vector<model::contact_site_ids_size>::Constant(1.0);
+    mj_deleteData(mj_data);
+    return state;
+}
+
+double elapsed_us(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// make_controller: Returns the controller for one sample, its model loading time is part of initialize()
+template <typename MakeController>
+StartupTimes measure(const State& initial_state, int iterations, MakeController&& make_controller) {
+    StartupTimes times;
+    for(int i = 0; i < iterations; i++) {
+        auto start = std::chrono::steady_clock::now();
+        OperationalSpaceController controller = make_controller();
+        times.model_us.push_back(elapsed_us(start));
+
+        start = std::chrono::steady_clock::now();
+        absl::Status result = controller.initialize(initial_state);
+        times.initialize_us.push_back(elapsed_us(start));
+
+        start = std::chrono::steady_clock::now();
+        result.Update(controller.initialize_optimization());
+        times.optimization_us.push_back(elapsed_us(start));
+
+        result.Update(controller.clean_up());
+        ABSL_CHECK(result.ok()) << result.message();
+    }
+    return times;
+}
+
+double percentile(std::vector<double> samples, double p) {
+    std::sort(samples.begin(), samples.end());
+    size_t index = std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()));
+    return samples[index];
+}
+
+void report(const std::string& name, const StartupTimes& times) {
+    std::vector<double> total(times.initialize_us.size());
+    for(size_t i = 0; i < total.size(); i++)
+        total[i] = times.model_us[i] + times.initialize_us[i] + times.optimization_us[i];
+
+    std::cout << name << std::endl;
+    std::cout << "  Model (us):                   p50 " << percentile(times.model_us, 0.5) << std::endl;
+    std::cout << "  initialize (us):              p50 " << percentile(times.initialize_us, 0.5)
+        << " | p99 " << percentile(times.initialize_us, 0.99) << std::endl;
+    std::cout << "  initialize_optimization (us): p50 " << percentile(times.optimization_us, 0.5)
+        << " | p99 " << percentile(times.optimization_us, 0.99) << std::endl;
+    std::cout << "  Total (us):                   p50 " << percentile(total, 0.5)
+        << " | p99 " << percentile(total, 0.99) << std::endl;
+}
+
+
+int main(int argc, char** argv) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::Create(argv[0], BAZEL_CURRENT_REPOSITORY, &error)
+    );
+    std::filesystem::path xml_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+
+    const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 100;
+
+    // Precompile the model once: (MJB file and in memory buffer)
+    auto shared_model = ControllerModel::load(xml_path);
+    ABSL_CHECK(shared_model.ok()) << shared_model.status().message();
+    const std::filesystem::path mjb_path = std::filesystem::temp_directory_path() / "osc_startup_go2.mjb";
+    absl::Status result = (*shared_model)->save(mjb_path);
+    ABSL_CHECK(result.ok()) << result.message();
+    const std::vector<uint8_t> mjb_buffer = (*shared_model)->to_buffer();
+    const State initial_state = keyframe_state((*shared_model)->mujoco_model());
+
+    report("xml (cold)", measure(initial_state, iterations, [&]() {
+        return OperationalSpaceController(xml_path);
+    }));
+    report("mjb file", measure(initial_state, iterations, [&]() {
+        return OperationalSpaceController(mjb_path);
+    }));
+    report("mjb buffer", measure(initial_state, iterations, [&]() {
+        auto buffer_model = ControllerModel::load_from_buffer(mjb_buffer.data(), static_cast<int>(mjb_buffer.size()));
+        ABSL_CHECK(buffer_model.ok()) << buffer_model.status().message();
+        return OperationalSpaceController(*buffer_model);
+    }));
+    report("shared model (warm)", measure(initial_state, iterations, [&]() {
+        return OperationalSpaceController(*shared_model);
+    }));
+
+    std::filesystem::remove(mjb_path);
+    return 0;
+}
@@ -0,0 +1,177 @@
+#include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/containers.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/operational_space_controller.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using operational_space_controller::ControlLoopMode;
+using operational_space_controller::ControlLoopTrigger;
+using rules_cc::cc::runfiles::Runfiles;
+
+
+struct LatencyDistribution {
+    std::vector<double> state_age_us;
+    uint64_t ticks;
+    uint64_t watchdog_ticks;
+    uint64_t dropped_states;
+    uint64_t reused_states;
+};
+
+State keyframe_state(const std::filesystem::path& simulation_model_path) {
+    char mj_error[1000];
+    mjModel* mj_model = mj_loadXML(simulation_model_path.c_str(), nullptr, mj_error, 1000);
+    ABSL_CHECK(mj_model) << mj_error;
+    mjData* mj_data = mj_makeData(mj_model);
+    mj_resetDataKeyframe(mj_model, mj_data, 0);
+    mj_forward(mj_model, mj_data);
+
+    Vector<model::nq_size> qpos = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos);
+    Vector<model::nv_size> qvel = Eigen::Map<Vector<model::nv_size>>(mj_data->qvel);
+    State state;
+    state.motor_position = qpos(Eigen::seqN(7, model::nu_size));
+    state.motor_velocity = qvel(Eigen::seqN(6, model::nu_size));
+    state.motor_acceleration = Vector<model::nu_size>::Zero();
+    state.torque_estimate = Vector<model::nu_size>::Zero();
+    state.body_rotation = qpos(Eigen::seqN(3, 4));
+    state.linear_body_velocity = qvel(Eigen::seqN(0, 3));
+    state.angular_body_velocity = qvel(Eigen::seqN(3, 3));
+    state.linear_body_acceleration = Vector<3>::Zero();
+    state.contact_mask = Vector<model::contact_site_ids_size>::Constant(1.0);
+
+    mj_deleteData(mj_data);
+    mj_deleteModel(mj_model);
+    return state;
+}
+
+/*
+    A sensor thread publishes samples on its own clock (period slightly shorter than the control
+    period, so its phase sweeps across the control schedule). Every tick's state age (time from
+    update_state() until the torque computed from that sample is published) is recorded, along with
+    the samples no tick used (dropped) and the ticks that ran on the previous tick's sample (reused).
+*/
+LatencyDistribution run(
+    const std::filesystem::path& osc_model_path,
+    const State& state,
+    ControlLoopTrigger trigger,
+    int control_rate_us,
+    double duration
+) {
+    OperationalSpaceController controller(osc_model_path, control_rate_us);
+    absl::Status result;
+    result.Update(controller.initialize(state));
+    result.Update(controller.initialize_optimization());
+    controller.update_taskspace_targets(TaskspaceTargets::Zero());
+    result.Update(controller.initialize_thread(ControlLoopMode::kSequential, trigger));
+    ABSL_CHECK(result.ok()) << result.message();
+
+    using Clock = std::chrono::steady_clock;
+    std::atomic<bool> sensor_running{true};
+    std::thread sensor([&]() {
+        auto sensor_period = std::chrono::microseconds(control_rate_us * 987 / 1000);
+        auto next_time = Clock::now();
+        while(sensor_running) {
+            controller.update_state(state);
+            next_time += sensor_period;
+            std::this_thread::sleep_until(next_time);
+        }
+    });
+
+    LatencyDistribution distribution;
+    distribution.state_age_us.reserve(static_cast<size_t>(duration * 1e6 / control_rate_us) + 1);
+    uint64_t last_tick = 0;
+    auto end_time = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(duration));
+    while(Clock::now() < end_time) {
+        auto statistics = controller.get_statistics();
+        if(statistics.ticks != last_tick) {
+            distribution.state_age_us.push_back(statistics.state_age_us);
+            last_tick = statistics.ticks;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(control_rate_us / 10));
+    }
+    sensor_running = false;
+    sensor.join();
+
+    result.Update(controller.stop_thread());
+    result.Update(controller.clean_up());
+    ABSL_CHECK(result.ok()) << result.message();
+
+    auto statistics = controller.get_statistics();
+    distribution.ticks = statistics.ticks;
+    distribution.watchdog_ticks = statistics.watchdog_ticks;
+    distribution.dropped_states = statistics.dropped_states;
+    distribution.reused_states = statistics.reused_states;
+    return distribution;
+}
+
+void report(const std::string& label, LatencyDistribution& distribution) {
+    std::vector<double>& samples = distribution.state_age_us;
+    if(samples.empty()) {
+        std::cout << std::setw(14) << label << "  no samples" << std::endl;
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](double p) {
+        return samples[static_cast<size_t>(p * (samples.size() - 1))];
+    };
+    double mean = 0.0;
+    for(double sample : samples)
+        mean += sample / samples.size();
+    std::cout << std::setw(14) << label
+        << std::setw(10) << distribution.ticks
+        << std::setw(10) << distribution.watchdog_ticks
+        << std::setw(12) << mean
+        << std::setw(12) << percentile(0.5)
+        << std::setw(12) << percentile(0.9)
+        << std::setw(12) << percentile(0.99)
+        << std::setw(12) << samples.back()
+        << std::setw(10) << distribution.dropped_states
+        << std::setw(10) << distribution.reused_states << std::endl;
+}
+
+
+int main(int argc, char** argv) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::Create(argv[0], BAZEL_CURRENT_REPOSITORY, &error)
+    );
+    std::filesystem::path osc_model_path = 
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+    std::filesystem::path simulation_model_path = 
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/scene_go2.xml");
+
+    const double duration = argc > 1 ? std::atof(argv[1]) : 5.0;
+    const int control_rate_us = argc > 2 ? std::atoi(argv[2]) : 2000;
+    const State state = keyframe_state(simulation_model_path);
+
+    LatencyDistribution periodic = run(osc_model_path, state, ControlLoopTrigger::kPeriodic, control_rate_us, duration);
+    LatencyDistribution state_update = run(osc_model_path, state, ControlLoopTrigger::kStateUpdate, control_rate_us, duration);
+
+    std::cout << "State-to-torque latency (us), control rate " << control_rate_us << "us:" << std::endl;
+    std::cout << std::setw(14) << "trigger" << std::setw(10) << "ticks" << std::setw(10) << "watchdog"
+        << std::setw(12) << "mean" << std::setw(12) << "p50" << std::setw(12) << "p90"
+        << std::setw(12) << "p99" << std::setw(12) << "max"
+        << std::setw(10) << "dropped" << std::setw(10) << "reused" << std::endl;
+    report("periodic", periodic);
+    report("state_update", state_update);
+
+    return 0;
+}
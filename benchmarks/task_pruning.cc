@@ -0,0 +1,189 @@
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/operational_space_controller.h"
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/autogen/translational_feet/autogen_defines.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using rules_cc::cc::runfiles::Runfiles;
+
+using FullController = operational_space_controller::OperationalSpaceController<operational_space_controller::unitree_go2::Descriptor>;
+using PrunedController = operational_space_controller::OperationalSpaceController<operational_space_controller::unitree_go2_translational_feet::Descriptor>;
+
+
+/*
+    Task Pruning Benchmark: Default task set (s_size 30) vs the translational feet task set (s_size 18),
+    generated from unitree_go2_translational_feet_config.yaml. Each controller drives its own simulation
+    through the standing and push up scenarios. Reports the taskspace rows, the step latency and the closed
+    loop tracking error of each.
+        Usage: task_pruning [duration_s]
+*/
+enum class Scenario { kStanding, kPushUp };
+
+struct RunResult {
+    std::vector<double> step_us;
+    double position_squared_error = 0.0;
+    double rotation_squared_error = 0.0;
+    uint64_t ticks = 0;
+    bool fell = false;
+};
+
+template <typename Controller>
+typename Controller::State get_state(const mjData* mj_data) {
+    Vector<model::nq_size> qpos = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos);
+    Vector<model::nv_size> qvel = Eigen::Map<Vector<model::nv_size>>(mj_data->qvel);
+    Vector<model::nv_size> qfrc_actuator = Eigen::Map<Vector<model::nv_size>>(mj_data->qfrc_actuator);
+
+    typename Controller::State state;
+    state.motor_position = qpos(Eigen::seqN(7, model::nu_size));
+    state.motor_velocity = qvel(Eigen::seqN(6, model::nu_size));
+    state.motor_acceleration = Vector<model::nu_size>::Zero();
+    state.torque_estimate = qfrc_actuator(Eigen::seqN(6, model::nu_size));
+    state.body_rotation = qpos(Eigen::seqN(3, 4));
+    state.linear_body_velocity = qvel(Eigen::seqN(0, 3));
+    state.angular_body_velocity = qvel(Eigen::seqN(3, 3));
+    state.linear_body_acceleration = Vector<3>::Zero();
+    state.contact_mask = Vector<model::contact_site_ids_size>::Constant(1.0);
+    return state;
+}
+
+template <typename Controller>
+RunResult run(
+    Scenario scenario,
+    double duration,
+    const std::filesystem::path& osc_model_path,
+    const mjModel* mj_model
+) {
+    mjData* mj_data = mj_makeData(mj_model);
+    mj_resetDataKeyframe(mj_model, mj_data, 0);
+    mj_forward(mj_model, mj_data);
+    const Vector<3> nominal_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+
+    Controller controller(osc_model_path);
+    absl::Status result;
+    result.Update(controller.initialize(get_state<Controller>(mj_data)));
+    result.Update(controller.initialize_optimization());
+    ABSL_CHECK(result.ok()) << result.message();
+
+    const int decimation = std::max(1, static_cast<int>(std::round(2000e-6 / mj_model->opt.timestep)));
+    Vector<model::nu_size> torque_command = Vector<model::nu_size>::Zero();
+    uint64_t simulation_steps = 0;
+
+    RunResult run_result;
+    while(mj_data->time < duration) {
+        if(simulation_steps % decimation == 0) {
+            const double time = mj_data->time;
+            auto state = get_state<Controller>(mj_data);
+            Vector<3> body_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+
+            // Scenario Targets: (Same as scenario_runner)
+            Vector<3> position_target = nominal_position;
+            Vector<3> velocity_target = Vector<3>::Zero();
+            if(scenario == Scenario::kPushUp) {
+                const double amplitude = 0.1;
+                const double frequency = 0.5;
+                position_target(2) += amplitude * std::sin(2.0 * M_PI * frequency * time);
+                velocity_target(2) = 2.0 * M_PI * amplitude * frequency * std::cos(2.0 * M_PI * frequency * time);
+            }
+            Eigen::Quaternion<double> body_rotation = Eigen::Quaternion<double>(state.body_rotation(0), state.body_rotation(1), state.body_rotation(2), state.body_rotation(3));
+            Vector<3> position_error = position_target - body_position;
+            Vector<3> velocity_error = velocity_target - state.linear_body_velocity;
+            Vector<3> rotation_error = (Eigen::Quaternion<double>(1, 0, 0, 0) * body_rotation.conjugate()).vec();
+            Vector<3> angular_velocity_error = Vector<3>::Zero() - state.angular_body_velocity;
+            Vector<3> linear_control = 150.0 * (position_error) + 25.0 * (velocity_error);
+            Vector<3> angular_control = 50.0 * (rotation_error) + 10.0 * (angular_velocity_error);
+            typename Controller::TaskspaceTargets taskspace_targets = Controller::TaskspaceTargets::Zero();
+            taskspace_targets.row(0) << linear_control.transpose(), angular_control.transpose();
+
+            controller.update_state(state);
+            controller.update_taskspace_targets(taskspace_targets);
+            auto start = std::chrono::steady_clock::now();
+            result.Update(controller.step());
+            run_result.step_us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+
+            run_result.position_squared_error += position_error.squaredNorm();
+            run_result.rotation_squared_error += rotation_error.squaredNorm();
+            run_result.ticks++;
+            torque_command = controller.get_torque_command();
+        }
+
+        mju_copy(mj_data->ctrl, torque_command.data(), model::nu_size);
+        mj_step(mj_model, mj_data);
+        simulation_steps++;
+
+        if(mj_data->qpos[2] < 0.5 * nominal_position(2)) {
+            run_result.fell = true;
+            break;
+        }
+    }
+    ABSL_CHECK(result.ok()) << result.message();
+
+    result.Update(controller.clean_up());
+    ABSL_CHECK(result.ok()) << result.message();
+    mj_deleteData(mj_data);
+    return run_result;
+}
+
+double percentile(std::vector<double> samples, double p) {
+    if(samples.empty())
+        return 0.0;
+    std::sort(samples.begin(), samples.end());
+    size_t index = std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()));
+    return samples[index];
+}
+
+void report(const std::string& name, int s_size, const RunResult& run_result) {
+    const double ticks = std::max<uint64_t>(run_result.ticks, 1);
+    std::cout << "  " << name << " (s_size " << s_size << ")" << (run_result.fell ? " | FELL" : "") << std::endl;
+    std::cout << "    Step latency (us):         p50 " << percentile(run_result.step_us, 0.5)
+        << " | p99 " << percentile(run_result.step_us, 0.99) << std::endl;
+    std::cout << "    Base position RMS error:   " << std::sqrt(run_result.position_squared_error / ticks) << std::endl;
+    std::cout << "    Base rotation RMS error:   " << std::sqrt(run_result.rotation_squared_error / ticks) << std::endl;
+}
+
+
+int main(int argc, char** argv) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::Create(argv[0], BAZEL_CURRENT_REPOSITORY, &error)
+    );
+    std::filesystem::path osc_model_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+    std::filesystem::path simulation_model_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/scene_go2.xml");
+
+    const double duration = argc > 1 ? std::atof(argv[1]) : 10.0;
+
+    char mj_error[1000];
+    mjModel* mj_model = mj_loadXML(simulation_model_path.c_str(), nullptr, mj_error, 1000);
+    ABSL_CHECK(mj_model) << mj_error;
+
+    bool fell = false;
+    for(auto [scenario, name] : {std::pair{Scenario::kStanding, "standing"}, std::pair{Scenario::kPushUp, "push_up"}}) {
+        std::cout << name << std::endl;
+        const RunResult full = run<FullController>(scenario, duration, osc_model_path, mj_model);
+        report("full", operational_space_controller::unitree_go2::optimization::s_size, full);
+        const RunResult pruned = run<PrunedController>(scenario, duration, osc_model_path, mj_model);
+        report("translational feet", operational_space_controller::unitree_go2_translational_feet::Descriptor::optimization::s_size, pruned);
+        fell |= full.fell || pruned.fell;
+    }
+
+    mj_deleteModel(mj_model);
+    return fell ? 2 : 0;
+}
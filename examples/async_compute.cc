@@ -0,0 +1,149 @@
+#include <filesystem>
+#include <algorithm>
+#include <cmath>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <iostream>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/containers.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/operational_space_controller.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using rules_cc::cc::runfiles::Runfiles;
+using ComputeResult = OperationalSpaceController::ComputeResult;
+
+
+/*
+    Asynchronous Compute Example: Headless Go2 standing, driven through the controller's executor.
+        1. Futures    : Submissions for a batch of states are pipelined and collected afterwards.
+        2. Coroutines : The simulation loop is a C++20 coroutine that co_awaits each control tick.
+    Usage: async_compute [duration_s]
+*/
+State get_state(const mjData* mj_data) {
+    Vector<model::nq_size> qpos = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos);
+    Vector<model::nv_size> qvel = Eigen::Map<Vector<model::nv_size>>(mj_data->qvel);
+    Vector<model::nv_size> qfrc_actuator = Eigen::Map<Vector<model::nv_size>>(mj_data->qfrc_actuator);
+
+    State state;
+    state.motor_position = qpos(Eigen::seqN(7, model::nu_size));
+    state.motor_velocity = qvel(Eigen::seqN(6, model::nu_size));
+    state.motor_acceleration = Vector<model::nu_size>::Zero();
+    state.torque_estimate = qfrc_actuator(Eigen::seqN(6, model::nu_size));
+    state.body_rotation = qpos(Eigen::seqN(3, 4));
+    state.linear_body_velocity = qvel(Eigen::seqN(0, 3));
+    state.angular_body_velocity = qvel(Eigen::seqN(3, 3));
+    state.linear_body_acceleration = Vector<3>::Zero();
+    state.contact_mask = Vector<model::contact_site_ids_size>::Constant(1.0);
+    return state;
+}
+
+TaskspaceTargets standing_targets(const mjData* mj_data, const State& state, const Vector<3>& nominal_position) {
+    Vector<3> body_position = Eigen::Map<const Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+    Eigen::Quaternion<double> body_rotation = Eigen::Quaternion<double>(state.body_rotation(0), state.body_rotation(1), state.body_rotation(2), state.body_rotation(3));
+    Vector<3> position_error = nominal_position - body_position;
+    Vector<3> velocity_error = Vector<3>::Zero() - state.linear_body_velocity;
+    Vector<3> rotation_error = (Eigen::Quaternion<double>(1, 0, 0, 0) * body_rotation.conjugate()).vec();
+    Vector<3> angular_velocity_error = Vector<3>::Zero() - state.angular_body_velocity;
+    Vector<3> linear_control = 150.0 * (position_error) + 25.0 * (velocity_error);
+    Vector<3> angular_control = 50.0 * (rotation_error) + 10.0 * (angular_velocity_error);
+    TaskspaceTargets taskspace_targets = TaskspaceTargets::Zero();
+    taskspace_targets.row(0) << linear_control.transpose(), angular_control.transpose();
+    return taskspace_targets;
+}
+
+// Minimal eager coroutine: (Completion is signaled through a std::promise)
+struct SimulationTask {
+    struct promise_type {
+        std::promise<void> done;
+        SimulationTask get_return_object() { return SimulationTask{done.get_future()}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() { done.set_value(); }
+        void unhandled_exception() { done.set_exception(std::current_exception()); }
+    };
+    std::future<void> done;
+};
+
+// Resumes on the executor thread after every tick and steps the simulation there:
+SimulationTask simulate(OperationalSpaceController& controller, const mjModel* mj_model, mjData* mj_data, double duration, uint64_t& ticks) {
+    const Vector<3> nominal_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+    const int decimation = std::max(1, static_cast<int>(std::round(0.002 / mj_model->opt.timestep)));
+    while(mj_data->time < duration) {
+        const State state = get_state(mj_data);
+        ComputeResult result = co_await controller.compute_async(state, standing_targets(mj_data, state, nominal_position));
+        ABSL_CHECK(result.ok()) << result.status().message();
+        ticks++;
+
+        mju_copy(mj_data->ctrl, result->torque.data(), model::nu_size);
+        for(int i = 0; i < decimation; i++)
+            mj_step(mj_model, mj_data);
+    }
+}
+
+
+int main(int argc, char** argv) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::Create(argv[0], BAZEL_CURRENT_REPOSITORY, &error)
+    );
+    std::filesystem::path osc_model_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+    std::filesystem::path simulation_model_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/scene_go2.xml");
+
+    const double duration = argc > 1 ? std::atof(argv[1]) : 5.0;
+
+    char mj_error[1000];
+    mjModel* mj_model = mj_loadXML(simulation_model_path.c_str(), nullptr, mj_error, 1000);
+    ABSL_CHECK(mj_model) << mj_error;
+    mjData* mj_data = mj_makeData(mj_model);
+    mj_resetDataKeyframe(mj_model, mj_data, 0);
+    mj_forward(mj_model, mj_data);
+    const Vector<3> nominal_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(0, 3));
+
+    OperationalSpaceController controller(osc_model_path);
+    absl::Status result = controller.initialize(get_state(mj_data));
+    result.Update(controller.initialize_optimization());
+    result.Update(controller.initialize_executor());
+    ABSL_CHECK(result.ok()) << result.message();
+
+    // 1. Futures: Pipeline a batch of submissions, then collect them in order
+    const State state = get_state(mj_data);
+    const TaskspaceTargets taskspace_targets = standing_targets(mj_data, state, nominal_position);
+    std::vector<std::future<ComputeResult>> futures;
+    for(int i = 0; i < 4; i++)
+        futures.push_back(controller.submit(state, taskspace_targets));
+    for(auto& future : futures) {
+        ComputeResult command = future.get();
+        ABSL_CHECK(command.ok()) << command.status().message();
+        std::cout << "state " << command->state_sequence << " -> torque in " << 1e-3 * command->age_ns() << "us" << std::endl;
+    }
+
+    // 2. Coroutines: Closed loop simulation, one co_await per control tick
+    uint64_t ticks = 0;
+    SimulationTask task = simulate(controller, mj_model, mj_data, duration, ticks);
+    task.done.get();
+
+    const auto statistics = controller.get_statistics();
+    std::cout << "Coroutine ticks: " << ticks << " | base height: " << mj_data->qpos[2]
+        << " | mean state age: " << statistics.mean_state_age_us << "us" << std::endl;
+
+    result.Update(controller.stop_thread());
+    result.Update(controller.clean_up());
+    ABSL_CHECK(result.ok()) << result.message();
+    mj_deleteData(mj_data);
+    mj_deleteModel(mj_model);
+    return 0;
+}
@@ -15,8 +15,7 @@
 #include "operational-space-control/unitree_go2/operational_space_controller.h"
 
 using namespace operational_space_controller::aliases;
-using namespace operational_space_controller::containers;
-using namespace operational_space_controller::constants;
+using namespace operational_space_controller::unitree_go2;
 using rules_cc::cc::runfiles::Runfiles;
 
 
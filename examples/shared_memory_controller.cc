@@ -0,0 +1,88 @@
+#include <filesystem>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "Eigen/Dense"
+
+#include "operational-space-control/shared_memory_transport.h"
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/containers.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/operational_space_controller.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using SharedMemoryTransport = operational_space_controller::transport::SharedMemoryTransport<Descriptor>;
+using rules_cc::cc::runfiles::Runfiles;
+
+
+/*
+    Controller process for shared_memory_driver: The control thread reads State from and writes
+    torque commands to the shared memory transport. This process only updates the standing targets.
+        Usage: shared_memory_controller [duration_s] [name]
+*/
+int main(int argc, char** argv) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::Create(argv[0], BAZEL_CURRENT_REPOSITORY, &error)
+    );
+    std::filesystem::path osc_model_path = 
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+
+    const double duration = argc > 1 ? std::atof(argv[1]) : 10.0;
+    const std::string name = argc > 2 ? argv[2] : "/osc_transport";
+
+    // Wait for the driver's first state sample:
+    SharedMemoryTransport transport;
+    absl::Status result = transport.attach(name);
+    ABSL_CHECK(result.ok()) << result.message();
+    State state;
+    int64_t timestamp_ns = 0;
+    while(transport.read_state(state, timestamp_ns) == 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    OperationalSpaceController controller(osc_model_path);
+    result.Update(controller.initialize(state));
+    result.Update(controller.initialize_optimization());
+    result.Update(controller.enable_shared_memory_transport(name));
+    controller.update_taskspace_targets(TaskspaceTargets::Zero());
+    result.Update(controller.initialize_thread());
+    ABSL_CHECK(result.ok()) << result.message();
+
+    // Standing Targets: (Orientation and velocity feedback, the base position is not part of State)
+    using Clock = std::chrono::steady_clock;
+    auto end_time = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(duration));
+    while(Clock::now() < end_time) {
+        if(transport.read_state(state, timestamp_ns) != 0) {
+            Eigen::Quaternion<double> body_rotation = Eigen::Quaternion<double>(state.body_rotation(0), state.body_rotation(1), state.body_rotation(2), state.body_rotation(3));
+            Vector<3> velocity_error = Vector<3>::Zero() - state.linear_body_velocity;
+            Vector<3> rotation_error = (Eigen::Quaternion<double>(1, 0, 0, 0) * body_rotation.conjugate()).vec();
+            Vector<3> angular_velocity_error = Vector<3>::Zero() - state.angular_body_velocity;
+            Vector<3> linear_control = 25.0 * (velocity_error);
+            Vector<3> angular_control = 50.0 * (rotation_error) + 10.0 * (angular_velocity_error);
+
+            TaskspaceTargets taskspace_targets = TaskspaceTargets::Zero();
+            taskspace_targets.row(0) << linear_control.transpose(), angular_control.transpose();
+            controller.update_taskspace_targets(taskspace_targets);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    result.Update(controller.stop_thread());
+    result.Update(controller.clean_up());
+    result.Update(transport.close());
+    ABSL_CHECK(result.ok()) << result.message();
+
+    auto statistics = controller.get_statistics();
+    std::cout << "Ticks: " << statistics.ticks << " | Overruns: " << statistics.overruns
+        << " | Max latency: " << statistics.max_latency_us << "us" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/shared_memory_transport.h"
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/containers.h"
+#include "operational-space-control/unitree_go2/constants.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using SharedMemoryTransport = operational_space_controller::transport::SharedMemoryTransport<Descriptor>;
+using rules_cc::cc::runfiles::Runfiles;
+
+
+/*
+    Stand-in hardware driver: Runs the Go2 simulation in real time and exchanges State and torque
+    commands with shared_memory_controller over the shared memory transport.
+    Reports the driver-to-torque latency: Time from writing a state sample until a torque command
+    computed from that sample is visible to the driver.
+        Usage: shared_memory_driver [duration_s] [name]  (start before shared_memory_controller)
+*/
+int main(int argc, char** argv) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::Create(argv[0], BAZEL_CURRENT_REPOSITORY, &error)
+    );
+    std::filesystem::path simulation_model_path = 
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/scene_go2.xml");
+
+    const double duration = argc > 1 ? std::atof(argv[1]) : 10.0;
+    const std::string name = argc > 2 ? argv[2] : "/osc_transport";
+
+    // Load Simulation Model
+    char mj_error[1000];
+    mjModel* mj_model = mj_loadXML(simulation_model_path.c_str(), nullptr, mj_error, 1000);
+    ABSL_CHECK(mj_model) << mj_error;
+    mjData* mj_data = mj_makeData(mj_model);
+    mj_resetDataKeyframe(mj_model, mj_data, 0);
+    mj_forward(mj_model, mj_data);
+
+    SharedMemoryTransport transport;
+    absl::Status result = transport.create(name);
+    ABSL_CHECK(result.ok()) << result.message();
+
+    // Torque Listener: Polls the torque slot and records the latency of every new command.
+    std::atomic<bool> running{true};
+    std::vector<double> latencies_us;
+    latencies_us.reserve(1000000);
+    Vector<model::nu_size> torque_command = Vector<model::nu_size>::Zero();
+    std::atomic<uint64_t> torque_updates{0};
+    std::mutex torque_mutex;
+    std::thread listener([&]() {
+        SharedMemoryTransport::TorqueRecord record;
+        uint64_t last_sequence = 0;
+        while(running) {
+            const uint64_t sequence = transport.read_torque(record);
+            if(sequence > last_sequence) {
+                const int64_t received_ns = operational_space_controller::transport::now_ns();
+                if(latencies_us.size() < latencies_us.capacity())
+                    latencies_us.push_back((received_ns - record.state_timestamp_ns) * 1e-3);
+                {
+                    std::lock_guard<std::mutex> lock(torque_mutex);
+                    torque_command = Eigen::Map<const Vector<model::nu_size>>(record.torque_command);
+                }
+                last_sequence = sequence;
+                torque_updates++;
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::cout << "Driver publishing on " << name << " for " << duration << "s" << std::endl;
+    using Clock = std::chrono::steady_clock;
+    auto next_time = Clock::now();
+    auto step_period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(mj_model->opt.timestep));
+    uint64_t states_published = 0;
+    while(mj_data->time < duration) {
+        Vector<model::nq_size> qpos = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos);
+        Vector<model::nv_size> qvel = Eigen::Map<Vector<model::nv_size>>(mj_data->qvel);
+        Vector<model::nv_size> qfrc_actuator = Eigen::Map<Vector<model::nv_size>>(mj_data->qfrc_actuator);
+
+        State state;
+        state.motor_position = qpos(Eigen::seqN(7, model::nu_size));
+        state.motor_velocity = qvel(Eigen::seqN(6, model::nu_size));
+        state.motor_acceleration = Vector<model::nu_size>::Zero();
+        state.torque_estimate = qfrc_actuator(Eigen::seqN(6, model::nu_size));
+        state.body_rotation = qpos(Eigen::seqN(3, 4));
+        state.linear_body_velocity = qvel(Eigen::seqN(0, 3));
+        state.angular_body_velocity = qvel(Eigen::seqN(3, 3));
+        state.linear_body_acceleration = Vector<3>::Zero();
+        state.contact_mask = Vector<model::contact_site_ids_size>::Constant(1.0);
+        transport.publish_state(state);
+        states_published++;
+
+        {
+            std::lock_guard<std::mutex> lock(torque_mutex);
+            mju_copy(mj_data->ctrl, torque_command.data(), model::nu_size);
+        }
+        mj_step(mj_model, mj_data);
+
+        next_time += step_period;
+        std::this_thread::sleep_until(next_time);
+    }
+    running = false;
+    listener.join();
+
+    // Latency Report:
+    std::cout << "States published: " << states_published << std::endl;
+    std::cout << "Torque commands received: " << torque_updates << std::endl;
+    if(!latencies_us.empty()) {
+        std::sort(latencies_us.begin(), latencies_us.end());
+        auto percentile = [&](double p) {
+            return latencies_us[static_cast<size_t>(p * (latencies_us.size() - 1))];
+        };
+        double mean = 0.0;
+        for(double latency : latencies_us)
+            mean += latency / latencies_us.size();
+        std::cout << "Driver-to-torque latency (us):" << std::endl;
+        std::cout << "  mean: " << mean << std::endl;
+        std::cout << "  p50:  " << percentile(0.5) << std::endl;
+        std::cout << "  p90:  " << percentile(0.9) << std::endl;
+        std::cout << "  p99:  " << percentile(0.99) << std::endl;
+        std::cout << "  max:  " << latencies_us.back() << std::endl;
+    }
+
+    result.Update(transport.close());
+    mj_deleteData(mj_data);
+    mj_deleteModel(mj_model);
+    ABSL_CHECK(result.ok()) << result.message();
+
+    return 0;
+}
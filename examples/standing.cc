@@ -14,8 +14,7 @@
 #include "operational-space-control/unitree_go2/operational_space_controller.h"
 
 using namespace operational_space_controller::aliases;
-using namespace operational_space_controller::containers;
-using namespace operational_space_controller::constants;
+using namespace operational_space_controller::unitree_go2;
 using rules_cc::cc::runfiles::Runfiles;
 
 
@@ -108,6 +107,10 @@ int main(int argc, char** argv) {
     result.Update(controller.initialize_optimization());
     ABSL_CHECK(result.ok()) << result.message();
 
+    // Optional Shared Memory Telemetry: (e.g. standing /osc_telemetry, attach with telemetry_monitor)
+    if(argc > 1)
+        result.Update(controller.enable_telemetry(argv[1]));
+
     // Initalize Controller Thread:
     controller.update_taskspace_targets(taskspace_targets);
     result.Update(controller.initialize_thread());
@@ -0,0 +1,60 @@
+#include <chrono>
+#include <thread>
+#include <string>
+#include <iostream>
+#include <iomanip>
+
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+
+#include "Eigen/Dense"
+
+#include "operational-space-control/telemetry.h"
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/constants.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using TelemetryReader = operational_space_controller::telemetry::TelemetryReader<Descriptor>;
+using TelemetryRecord = operational_space_controller::telemetry::TelemetryRecord<Descriptor>;
+
+
+// Attaches to a controller's telemetry ring and prints the latest tick at 10 Hz:
+int main(int argc, char** argv) {
+    const std::string name = argc > 1 ? argv[1] : "/osc_telemetry";
+
+    TelemetryReader reader;
+    absl::Status result = reader.open(name);
+    ABSL_CHECK(result.ok()) << result.message();
+
+    TelemetryRecord record;
+    uint64_t previous_head = reader.head();
+    std::cout << std::fixed << std::setprecision(3);
+    while(true) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        const uint64_t head = reader.head();
+        if(!reader.read_latest(record)) {
+            std::cout << "Waiting for telemetry..." << std::endl;
+            continue;
+        }
+
+        // Contact Normal Forces: (z component of each contact force)
+        Vector<model::contact_site_ids_size> normal_forces;
+        for(int i = 0; i < model::contact_site_ids_size; i++)
+            normal_forces(i) = record.contact_forces[3 * i + 2];
+
+        std::cout << "tick: " << record.tick
+            << " | ticks/s: " << (head - previous_head) * 10
+            << " | exit code: " << record.exit_code
+            << " | model: " << record.model_stage_us << "us"
+            << " | solver: " << record.solver_stage_us << "us"
+            << " | latency: " << record.latency_us << "us"
+            << " | state age: " << 1e-3 * (record.timestamp_ns - record.state_timestamp_ns) << "us" << std::endl;
+        std::cout << "  torque: " << Eigen::Map<const Vector<model::nu_size>>(record.torque_command).transpose() << std::endl;
+        std::cout << "  normal forces: " << normal_forces.transpose() << std::endl;
+        previous_head = head;
+    }
+
+    return 0;
+}
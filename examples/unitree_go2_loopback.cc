@@ -0,0 +1,210 @@
+#include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+
+#include "absl/status/status.h"
+#include "absl/log/absl_check.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/unitree_go2/aliases.h"
+#include "operational-space-control/unitree_go2/containers.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/low_level.h"
+#include "operational-space-control/unitree_go2/operational_space_controller.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using namespace operational_space_controller::unitree_go2::low_level;
+using rules_cc::cc::runfiles::Runfiles;
+
+
+/*
+    Unitree Go2 Loopback Example: The controller talks low level messages over 127.0.0.1 UDP to a stand-in robot.
+        Robot      : Runs the Go2 simulation in real time, publishes LowState at 500 Hz and applies the torques
+                     of every LowCmd with a valid CRC.
+        Controller : Decodes each LowState into its State, steps and encodes the torque command into a LowCmd.
+    The low level state carries no base position or linear velocity, so the targets only stabilize the
+    base orientation. Exits non-zero if the robot fell.
+        Usage: unitree_go2_loopback [duration_s] [state_port] [command_port]
+*/
+// Stand-in Robot: (Simulation actuators are in Unitree motor order FR, FL, RR, RL)
+struct Robot {
+    const mjModel* mj_model;
+    mjData* mj_data;
+    UdpEndpoint endpoint;
+    std::atomic<bool> running{true};
+    uint64_t states_sent = 0;
+    uint64_t commands_applied = 0;
+    uint64_t crc_errors = 0;
+
+    void write_state(LowState& low_state) {
+        const mjtNum* qpos = mj_data->qpos;
+        const mjtNum* qvel = mj_data->qvel;
+        for(int i = 0; i < model::nu_size; i++) {
+            MotorState& motor_state = low_state.motor_state[i];
+            motor_state.mode = kServoMode;
+            motor_state.q = static_cast<float>(qpos[7 + i]);
+            motor_state.dq = static_cast<float>(qvel[6 + i]);
+            motor_state.ddq = static_cast<float>(mj_data->qacc[6 + i]);
+            motor_state.tau_est = static_cast<float>(mj_data->qfrc_actuator[6 + i]);
+        }
+        for(int i = 0; i < 4; i++)
+            low_state.imu_state.quaternion[i] = static_cast<float>(qpos[3 + i]);
+        for(int i = 0; i < 3; i++)
+            low_state.imu_state.gyroscope[i] = static_cast<float>(qvel[3 + i]);
+        // Feet loaded while standing: (Raw foot force units)
+        for(int i = 0; i < kFeet; i++)
+            low_state.foot_force[i] = 100;
+        low_state.tick = static_cast<uint32_t>(std::llround(1e3 * mj_data->time));
+        low_state.crc = message_crc(low_state);
+    }
+
+    void run(double duration) {
+        const int decimation = std::max(1, static_cast<int>(std::round(0.002 / mj_model->opt.timestep)));
+        LowState low_state;
+        std::memset(&low_state, 0, sizeof(LowState));
+        LowCmd low_cmd;
+        Vector<model::nu_size> torque = Vector<model::nu_size>::Zero();
+
+        auto next_step = std::chrono::steady_clock::now();
+        const auto step_period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(mj_model->opt.timestep)
+        );
+        uint64_t simulation_steps = 0;
+        while(mj_data->time < duration) {
+            // Apply the latest command with a valid CRC:
+            while(endpoint.receive(low_cmd, 0).ok()) {
+                if(message_crc(low_cmd) != low_cmd.crc) {
+                    crc_errors++;
+                    continue;
+                }
+                for(int i = 0; i < model::nu_size; i++) {
+                    const MotorCmd& motor_cmd = low_cmd.motor_cmd[i];
+                    torque(i) = motor_cmd.tau + motor_cmd.kd * (0.0 - mj_data->qvel[6 + i]);
+                }
+                commands_applied++;
+            }
+
+            if(simulation_steps % decimation == 0) {
+                write_state(low_state);
+                ABSL_CHECK(endpoint.send(low_state).ok()) << "Failed to send LowState.";
+                states_sent++;
+            }
+
+            mju_copy(mj_data->ctrl, torque.data(), model::nu_size);
+            mj_step(mj_model, mj_data);
+            simulation_steps++;
+
+            next_step += step_period;
+            std::this_thread::sleep_until(next_step);
+        }
+        running.store(false);
+    }
+};
+
+// Orientation Targets: (Same angular gains as standing)
+TaskspaceTargets orientation_targets(const State& state) {
+    Eigen::Quaternion<double> body_rotation = Eigen::Quaternion<double>(state.body_rotation(0), state.body_rotation(1), state.body_rotation(2), state.body_rotation(3));
+    Vector<3> rotation_error = (Eigen::Quaternion<double>(1, 0, 0, 0) * body_rotation.conjugate()).vec();
+    Vector<3> angular_velocity_error = Vector<3>::Zero() - state.angular_body_velocity;
+    Vector<3> angular_control = 50.0 * (rotation_error) + 10.0 * (angular_velocity_error);
+    TaskspaceTargets taskspace_targets = TaskspaceTargets::Zero();
+    taskspace_targets.row(0) << Vector<3>::Zero().transpose(), angular_control.transpose();
+    return taskspace_targets;
+}
+
+
+int main(int argc, char** argv) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::Create(argv[0], BAZEL_CURRENT_REPOSITORY, &error)
+    );
+    std::filesystem::path osc_model_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+    std::filesystem::path simulation_model_path =
+        runfiles->Rlocation("mujoco-models/models/unitree_go2/scene_go2.xml");
+
+    const double duration = argc > 1 ? std::atof(argv[1]) : 5.0;
+    const uint16_t state_port = argc > 2 ? static_cast<uint16_t>(std::atoi(argv[2])) : 9001;
+    const uint16_t command_port = argc > 3 ? static_cast<uint16_t>(std::atoi(argv[3])) : 9002;
+
+    char mj_error[1000];
+    mjModel* mj_model = mj_loadXML(simulation_model_path.c_str(), nullptr, mj_error, 1000);
+    ABSL_CHECK(mj_model) << mj_error;
+    mjData* mj_data = mj_makeData(mj_model);
+    mj_resetDataKeyframe(mj_model, mj_data, 0);
+    mj_forward(mj_model, mj_data);
+    const double nominal_height = mj_data->qpos[2];
+
+    // Robot publishes on state_port and listens on command_port, the controller the other way around:
+    Robot robot{mj_model, mj_data};
+    absl::Status result = robot.endpoint.open(command_port, state_port);
+    UdpEndpoint endpoint;
+    result.Update(endpoint.open(state_port, command_port));
+    ABSL_CHECK(result.ok()) << result.message();
+    std::thread robot_thread(&Robot::run, &robot, duration);
+
+    // Initialize from the first LowState:
+    LowLevelAdapter adapter;
+    LowState low_state;
+    State state;
+    state.linear_body_velocity = Vector<3>::Zero();
+    do {
+        result = endpoint.receive(low_state, 100);
+    } while(absl::IsDeadlineExceeded(result) && robot.running.load());
+    result.Update(adapter.decode(low_state, state));
+    ABSL_CHECK(result.ok()) << result.message();
+
+    OperationalSpaceController controller(osc_model_path);
+    result = controller.initialize(state);
+    result.Update(controller.initialize_optimization());
+    ABSL_CHECK(result.ok()) << result.message();
+
+    // Control Loop: One tick per received LowState
+    uint64_t ticks = 0;
+    double decode_us = 0.0, encode_us = 0.0;
+    while(robot.running.load()) {
+        absl::Status received = endpoint.receive(low_state, 100);
+        if(absl::IsDeadlineExceeded(received))
+            continue;
+        ABSL_CHECK(received.ok()) << received.message();
+
+        auto start = std::chrono::steady_clock::now();
+        result.Update(adapter.decode(low_state, state));
+        decode_us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        controller.update_state(state);
+        controller.update_taskspace_targets(orientation_targets(state));
+        result.Update(controller.step());
+
+        start = std::chrono::steady_clock::now();
+        const LowCmd& low_cmd = adapter.encode(controller.get_torque_command());
+        encode_us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        result.Update(endpoint.send(low_cmd));
+        ABSL_CHECK(result.ok()) << result.message();
+        ticks++;
+    }
+    robot_thread.join();
+
+    const bool fell = mj_data->qpos[2] < 0.5 * nominal_height;
+    std::cout << "LowState sent: " << robot.states_sent << " | ticks: " << ticks
+        << " | LowCmd applied: " << robot.commands_applied << " | CRC errors: " << robot.crc_errors << std::endl;
+    std::cout << "Mean decode: " << (ticks ? decode_us / ticks : 0.0) << "us | mean encode: " << (ticks ? encode_us / ticks : 0.0)
+        << "us | base height: " << mj_data->qpos[2] << (fell ? "  FELL" : "") << std::endl;
+
+    result.Update(controller.clean_up());
+    ABSL_CHECK(result.ok()) << result.message();
+    mj_deleteData(mj_data);
+    mj_deleteModel(mj_model);
+    return fell ? 2 : 0;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <Eigen/Dense>
+
+
+namespace operational_space_controller {
+    namespace aliases {
+        template <int Rows_, int Cols_, typename Scalar_ = double>
+        using Matrix = Eigen::Matrix<Scalar_, Rows_, Cols_, Eigen::RowMajor>;
+        
+        template <int Rows_, typename Scalar_ = double>
+        using Vector = Eigen::Matrix<Scalar_, Rows_, 1>;
+
+        template <int Rows_, int Cols_, typename Scalar_ = double>
+        using MatrixColMajor = Eigen::Matrix<Scalar_, Rows_, Cols_, Eigen::ColMajor>;
+    }
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+
+#include "operational-space-control/aliases.h"
+#include "operational-space-control/containers.h"
+
+using namespace operational_space_controller::aliases;
+
+
+namespace operational_space_controller {
+    namespace async_compute {
+        template <typename Descriptor>
+        using ComputeResult = absl::StatusOr<containers::TorqueCommand<Descriptor>>;
+
+        // Runs on the executor thread: (Keep it short, e.g. hand the result to the caller's event loop)
+        template <typename Descriptor>
+        using ComputeCallback = std::function<void(ComputeResult<Descriptor>)>;
+
+        template <typename Descriptor>
+        struct ComputeRequest {
+            containers::State<Descriptor> state;
+            Matrix<Descriptor::model::site_ids_size, 6> taskspace_targets;
+            ComputeCallback<Descriptor> callback;
+        };
+
+        /*
+            Compute Executor: One worker thread running posted requests in submission order.
+            The queue is preallocated with capacity slots, so up to capacity submissions can be in flight
+            (pipelined behind each other) and post() fails with ResourceExhaustedError beyond that instead of blocking.
+            Requests still queued when the executor stops are handed to the handler with cancelled set.
+        */
+        template <typename Request>
+        class ComputeExecutor {
+            public:
+                using Handler = std::function<void(Request& request, bool cancelled)>;
+
+                ~ComputeExecutor() {
+                    stop();
+                }
+
+                absl::Status start(Handler new_handler, size_t capacity) {
+                    if(thread.joinable())
+                        return absl::FailedPreconditionError("Compute executor already started.");
+                    if(capacity == 0)
+                        return absl::InvalidArgumentError("Compute executor capacity must be positive.");
+
+                    handler = std::move(new_handler);
+                    requests.assign(capacity, Request());
+                    head = 0;
+                    tail = 0;
+                    running = true;
+                    thread = std::thread(&ComputeExecutor::worker_loop, this);
+                    return absl::OkStatus();
+                }
+
+                absl::Status post(Request&& request) {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if(!running)
+                            return absl::FailedPreconditionError("Compute executor is not running.");
+                        if(tail - head == requests.size())
+                            return absl::ResourceExhaustedError("Compute executor queue is full.");
+                        requests[tail % requests.size()] = std::move(request);
+                        tail++;
+                    }
+                    request_posted.notify_one();
+                    return absl::OkStatus();
+                }
+
+                // Finishes the running request and cancels the queued ones:
+                void stop() {
+                    if(!thread.joinable())
+                        return;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        running = false;
+                    }
+                    request_posted.notify_one();
+                    thread.join();
+                }
+
+                bool is_running() const {
+                    return thread.joinable();
+                }
+
+                // Submissions queued or running:
+                size_t in_flight() {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    return tail - head;
+                }
+
+            private:
+                void worker_loop() {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    while(true) {
+                        request_posted.wait(lock, [this]() { return head != tail || !running; });
+                        if(head == tail)
+                            break;
+
+                        // The slot at head is not reused by post() until head advances:
+                        const bool cancelled = !running;
+                        Request& request = requests[head % requests.size()];
+                        lock.unlock();
+                        handler(request, cancelled);
+                        // Releases the callback's captures:
+                        request = Request();
+                        lock.lock();
+                        head++;
+                    }
+                }
+
+                Handler handler;
+                std::vector<Request> requests;
+                uint64_t head = 0;
+                uint64_t tail = 0;
+                bool running = false;
+                std::mutex mutex;
+                std::condition_variable request_posted;
+                std::thread thread;
+        };
+
+        /*
+            Compute Awaitable: co_await controller.compute_async(state, targets) in a C++20 coroutine.
+            The coroutine resumes on the controller's executor thread with the ComputeResult, or right away
+            if the submission was rejected.
+        */
+        template <typename Controller>
+        class ComputeAwaitable {
+            public:
+                using State = typename Controller::State;
+                using TaskspaceTargets = typename Controller::TaskspaceTargets;
+                using Result = typename Controller::ComputeResult;
+
+                ComputeAwaitable(Controller& controller, const State& state, const TaskspaceTargets& taskspace_targets) :
+                    controller(controller), state(state), taskspace_targets(taskspace_targets) {}
+
+                bool await_ready() const noexcept {
+                    return false;
+                }
+
+                // The callback may resume the coroutine before submit() returns: (No member access after a successful submission)
+                bool await_suspend(std::coroutine_handle<> handle) {
+                    absl::Status submitted = controller.submit(state, taskspace_targets, [this, handle](Result new_result) {
+                        result.emplace(std::move(new_result));
+                        handle.resume();
+                    });
+                    if(submitted.ok())
+                        return true;
+                    result.emplace(std::move(submitted));
+                    return false;
+                }
+
+                Result await_resume() {
+                    return std::move(*result);
+                }
+
+            private:
+                Controller& controller;
+                State state;
+                TaskspaceTargets taskspace_targets;
+                std::optional<Result> result;
+        };
+    }
+}
@@ -0,0 +1,325 @@
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/aliases.h"
+#include "operational-space-control/async_compute.h"
+#include "operational-space-control/containers.h"
+#include "operational-space-control/unitree_go2/operational_space_controller.h"
+
+using namespace operational_space_controller;
+using namespace operational_space_controller::aliases;
+using rules_cc::cc::runfiles::Runfiles;
+
+
+/*
+    Asynchronous Compute Tests: ComputeExecutor queue limits, cancellation on stop and restart, handlers that
+    re-enter the executor, coroutine resumption through ComputeAwaitable, and stop / restart of the Go2 controller's
+    executor and control threads.
+*/
+namespace {
+    // Minimal descriptor: (State and TorqueCommand only read these sizes)
+    struct TestDescriptor {
+        struct model {
+            static constexpr int nu_size = 2;
+            static constexpr int site_ids_size = 1;
+            static constexpr int contact_site_ids_size = 1;
+        };
+    };
+
+    struct Request {
+        int value = 0;
+        std::function<void(int value, bool cancelled)> done;
+    };
+
+    using Executor = async_compute::ComputeExecutor<Request>;
+
+    constexpr auto kTimeout = std::chrono::seconds(5);
+
+    TEST(ComputeExecutorTest, RejectsSubmissionsBeyondCapacity) {
+        Executor executor;
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        std::atomic<int> completed{0};
+        ASSERT_TRUE(executor.start([&](Request& request, bool cancelled) {
+            released.wait();
+            request.done(request.value, cancelled);
+        }, 2).ok());
+
+        auto count = [&](int, bool) { completed++; };
+        ASSERT_TRUE(executor.post(Request{1, count}).ok());
+        ASSERT_TRUE(executor.post(Request{2, count}).ok());
+        // The running submission still holds its slot:
+        EXPECT_EQ(executor.in_flight(), 2u);
+        EXPECT_TRUE(absl::IsResourceExhausted(executor.post(Request{3, count})));
+
+        release.set_value();
+        const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+        while(executor.in_flight() != 0 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::yield();
+        EXPECT_EQ(completed.load(), 2);
+        EXPECT_TRUE(executor.post(Request{4, count}).ok());
+        executor.stop();
+    }
+
+    // The handler calls back into the executor: (Deadlocks if it ran with the mutex held)
+    TEST(ComputeExecutorTest, HandlerRunsOutsideTheMutex) {
+        Executor executor;
+        std::promise<std::vector<int>> chain;
+        std::vector<int> values;
+        ASSERT_TRUE(executor.start([&](Request& request, bool cancelled) {
+            request.done(request.value, cancelled);
+        }, 1).ok());
+
+        std::function<void(int, bool)> resubmit = [&](int value, bool) {
+            values.push_back(value);
+            EXPECT_EQ(executor.in_flight(), 1u);
+            if(value < 3)
+                EXPECT_TRUE(absl::IsResourceExhausted(executor.post(Request{value + 1, resubmit})));
+            else
+                chain.set_value(values);
+        };
+        // One slot: Resubmitting from the handler is rejected instead of blocking
+        for(int value = 1; value <= 3; value++) {
+            const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+            while(!executor.post(Request{value, resubmit}).ok() && std::chrono::steady_clock::now() < deadline)
+                std::this_thread::yield();
+        }
+
+        std::future<std::vector<int>> result = chain.get_future();
+        ASSERT_EQ(result.wait_for(kTimeout), std::future_status::ready);
+        EXPECT_EQ(result.get(), std::vector<int>({1, 2, 3}));
+        executor.stop();
+    }
+
+    TEST(ComputeExecutorTest, StopCancelsQueuedSubmissionsAndRestarts) {
+        Executor executor;
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        std::vector<std::pair<int, bool>> results;
+        auto record = [&](int value, bool cancelled) { results.emplace_back(value, cancelled); };
+        ASSERT_TRUE(executor.start([&](Request& request, bool cancelled) {
+            if(request.value == 1)
+                released.wait();
+            request.done(request.value, cancelled);
+        }, 3).ok());
+
+        ASSERT_TRUE(executor.post(Request{1, record}).ok());
+        ASSERT_TRUE(executor.post(Request{2, record}).ok());
+        ASSERT_TRUE(executor.post(Request{3, record}).ok());
+
+        // Full queue until stop() marks the executor as stopped:
+        std::thread stopper([&]() { executor.stop(); });
+        const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+        absl::Status post_result;
+        do {
+            post_result = executor.post(Request{4, record});
+        } while(absl::IsResourceExhausted(post_result) && std::chrono::steady_clock::now() < deadline);
+        EXPECT_TRUE(absl::IsFailedPrecondition(post_result));
+        release.set_value();
+        stopper.join();
+
+        // The running submission completes, the queued ones are cancelled:
+        const std::vector<std::pair<int, bool>> expected = {{1, false}, {2, true}, {3, true}};
+        EXPECT_EQ(results, expected);
+        EXPECT_FALSE(executor.is_running());
+
+        // Restart:
+        results.clear();
+        ASSERT_TRUE(executor.start([&](Request& request, bool cancelled) {
+            request.done(request.value, cancelled);
+        }, 3).ok());
+        ASSERT_TRUE(executor.post(Request{5, record}).ok());
+        const auto restart_deadline = std::chrono::steady_clock::now() + kTimeout;
+        while(executor.in_flight() != 0 && std::chrono::steady_clock::now() < restart_deadline)
+            std::this_thread::yield();
+        executor.stop();
+        EXPECT_EQ(results, (std::vector<std::pair<int, bool>>{{5, false}}));
+    }
+
+    // Stand in for the controller: (Echoes the state's motor positions as the torque)
+    struct EchoController {
+        using State = containers::State<TestDescriptor>;
+        using TaskspaceTargets = Matrix<TestDescriptor::model::site_ids_size, 6>;
+        using ComputeResult = async_compute::ComputeResult<TestDescriptor>;
+        using ComputeRequest = async_compute::ComputeRequest<TestDescriptor>;
+
+        absl::Status start() {
+            return executor.start([](ComputeRequest& request, bool cancelled) {
+                if(cancelled) {
+                    request.callback(absl::CancelledError("Stopped."));
+                    return;
+                }
+                containers::TorqueCommand<TestDescriptor> command;
+                command.torque = request.state.motor_position;
+                command.state_sequence = request.state.sequence;
+                request.callback(command);
+            }, 4);
+        }
+
+        absl::Status submit(const State& state, const TaskspaceTargets&, async_compute::ComputeCallback<TestDescriptor> callback) {
+            return executor.post(ComputeRequest{state, TaskspaceTargets::Zero(), std::move(callback)});
+        }
+
+        async_compute::ComputeAwaitable<EchoController> compute_async(const State& state) {
+            return async_compute::ComputeAwaitable<EchoController>(*this, state, TaskspaceTargets::Zero());
+        }
+
+        async_compute::ComputeExecutor<ComputeRequest> executor;
+    };
+
+    struct Task {
+        struct promise_type {
+            std::promise<void> done;
+            Task get_return_object() { return Task{done.get_future()}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() { done.set_value(); }
+            void unhandled_exception() { done.set_exception(std::current_exception()); }
+        };
+        std::future<void> done;
+    };
+
+    struct Resumption {
+        uint64_t sequence = 0;
+        double torque = 0.0;
+        std::thread::id thread;
+        absl::Status status;
+    };
+
+    Task await_ticks(EchoController& controller, int ticks, std::vector<Resumption>& resumptions) {
+        for(int i = 1; i <= ticks; i++) {
+            EchoController::State state;
+            state.motor_position = Vector<TestDescriptor::model::nu_size>::Constant(i);
+            state.sequence = i;
+            EchoController::ComputeResult result = co_await controller.compute_async(state);
+            Resumption resumption;
+            resumption.thread = std::this_thread::get_id();
+            resumption.status = result.status();
+            if(result.ok()) {
+                resumption.sequence = result->state_sequence;
+                resumption.torque = result->torque(0);
+            }
+            resumptions.push_back(resumption);
+        }
+    }
+
+    TEST(ComputeAwaitableTest, ResumesOnTheExecutorThread) {
+        EchoController controller;
+        ASSERT_TRUE(controller.start().ok());
+        std::vector<Resumption> resumptions;
+        Task task = await_ticks(controller, 3, resumptions);
+        ASSERT_EQ(task.done.wait_for(kTimeout), std::future_status::ready);
+        controller.executor.stop();
+
+        ASSERT_EQ(resumptions.size(), 3u);
+        for(int i = 0; i < 3; i++) {
+            EXPECT_TRUE(resumptions[i].status.ok());
+            EXPECT_EQ(resumptions[i].sequence, static_cast<uint64_t>(i + 1));
+            EXPECT_EQ(resumptions[i].torque, i + 1);
+            EXPECT_NE(resumptions[i].thread, std::this_thread::get_id());
+        }
+    }
+
+    // A rejected submission resumes the coroutine right away with the error:
+    TEST(ComputeAwaitableTest, RejectedSubmissionResumesImmediately) {
+        EchoController controller;
+        std::vector<Resumption> resumptions;
+        Task task = await_ticks(controller, 1, resumptions);
+        ASSERT_EQ(task.done.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        ASSERT_EQ(resumptions.size(), 1u);
+        EXPECT_TRUE(absl::IsFailedPrecondition(resumptions[0].status));
+        EXPECT_EQ(resumptions[0].thread, std::this_thread::get_id());
+    }
+
+    class ControllerRestartTest : public ::testing::Test {
+        protected:
+            using Controller = unitree_go2::OperationalSpaceController;
+            using model = unitree_go2::model;
+
+            void SetUp() override {
+                std::string error;
+                std::unique_ptr<Runfiles> runfiles(Runfiles::CreateForTest(&error));
+                ASSERT_NE(runfiles, nullptr) << error;
+                xml_path = runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+                char mj_error[1000];
+                mj_model = mj_loadXML(xml_path.c_str(), nullptr, mj_error, 1000);
+                ASSERT_NE(mj_model, nullptr) << mj_error;
+                mj_data = mj_makeData(mj_model);
+                mj_resetDataKeyframe(mj_model, mj_data, 0);
+                mj_forward(mj_model, mj_data);
+            }
+
+            void TearDown() override {
+                if(mj_data)
+                    mj_deleteData(mj_data);
+                if(mj_model)
+                    mj_deleteModel(mj_model);
+            }
+
+            Controller::State keyframe_state() const {
+                Controller::State state;
+                state.motor_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(7, model::nu_size));
+                state.motor_velocity = Vector<model::nu_size>::Zero();
+                state.motor_acceleration = Vector<model::nu_size>::Zero();
+                state.torque_estimate = Vector<model::nu_size>::Zero();
+                state.body_rotation = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(3, 4));
+                state.linear_body_velocity = Vector<3>::Zero();
+                state.angular_body_velocity = Vector<3>::Zero();
+                state.linear_body_acceleration = Vector<3>::Zero();
+                state.contact_mask = Vector<model::contact_site_ids_size>::Constant(1.0);
+                return state;
+            }
+
+            std::filesystem::path xml_path;
+            mjModel* mj_model = nullptr;
+            mjData* mj_data = nullptr;
+    };
+
+    TEST_F(ControllerRestartTest, StopsAndRestartsEveryThreadMode) {
+        Controller controller(xml_path);
+        ASSERT_TRUE(controller.initialize(keyframe_state()).ok());
+        ASSERT_TRUE(controller.initialize_optimization().ok());
+        const Controller::TaskspaceTargets targets = Controller::TaskspaceTargets::Zero();
+
+        // Executor, stopped and started again:
+        for(int run = 0; run < 2; run++) {
+            ASSERT_TRUE(controller.initialize_executor().ok()) << run;
+            EXPECT_TRUE(controller.is_thread_initialized());
+            std::future<Controller::ComputeResult> result = controller.submit(keyframe_state(), targets);
+            ASSERT_EQ(result.wait_for(kTimeout), std::future_status::ready);
+            EXPECT_TRUE(result.get().ok());
+            ASSERT_TRUE(controller.stop_thread().ok());
+            EXPECT_FALSE(controller.is_thread_initialized());
+        }
+
+        // Control thread in both modes after the executor:
+        for(const ControlLoopMode mode : {ControlLoopMode::kSequential, ControlLoopMode::kPipelined, ControlLoopMode::kPipelined}) {
+            const uint64_t ticks = controller.get_statistics().ticks;
+            ASSERT_TRUE(controller.initialize_thread(mode).ok());
+            const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+            while(controller.get_statistics().ticks < ticks + 5 && std::chrono::steady_clock::now() < deadline)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            EXPECT_GE(controller.get_statistics().ticks, ticks + 5);
+            ASSERT_TRUE(controller.stop_thread().ok());
+        }
+        EXPECT_TRUE(absl::IsFailedPrecondition(controller.stop_thread()));
+        EXPECT_TRUE(controller.clean_up().ok());
+    }
+}
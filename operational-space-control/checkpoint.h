@@ -0,0 +1,332 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "absl/status/status.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/aliases.h"
+#include "operational-space-control/containers.h"
+#include "operational-space-control/shared_memory.h"
+
+using namespace operational_space_controller::aliases;
+
+
+namespace operational_space_controller {
+    namespace checkpoint {
+        // Layout version: Bump on any change to CheckpointHeader or CheckpointRecord.
+        constexpr uint32_t kCheckpointMagic = 0x5043534f;  // "OSCP"
+        constexpr uint32_t kCheckpointVersion = 1;
+
+        /*
+            Checkpoint Record: Runtime state of the controller after one tick.
+            Plain arrays only, like the telemetry record. The QP is the one the solution was computed from,
+            stored in Descriptor::Scalar and in the storage order of OptimizationData.
+        */
+        template <typename Descriptor>
+        struct CheckpointRecord {
+            using model = typename Descriptor::model;
+            using optimization = typename Descriptor::optimization;
+            using Scalar = typename Descriptor::Scalar;
+
+            // Checkpoint number: (Increasing across restarts, the latest complete record is restored)
+            uint64_t count;
+            uint64_t tick;
+            int64_t timestamp_ns;
+            int32_t exit_code;
+            uint32_t reserved;
+            // State:
+            uint64_t state_sequence;
+            int64_t state_timestamp_ns;
+            double motor_position[model::nu_size];
+            double motor_velocity[model::nu_size];
+            double motor_acceleration[model::nu_size];
+            double torque_estimate[model::nu_size];
+            double body_rotation[4];
+            double linear_body_velocity[3];
+            double angular_body_velocity[3];
+            double linear_body_acceleration[3];
+            double contact_mask[model::contact_site_ids_size];
+            // Inputs and Runtime Parameters:
+            double taskspace_targets[model::site_ids_size * 6];
+            double task_weights[optimization::s_size];
+            double torque_weight;
+            double regularization_weight;
+            double friction_coefficient;
+            // Torque Command: (Completion time of the checkpointed tick)
+            double torque_command[model::nu_size];
+            int64_t command_timestamp_ns;
+            // Warm Start:
+            double solution[optimization::design_vector_size];
+            double dual_solution[optimization::constraint_matrix_rows];
+            // QP:
+            Scalar H[optimization::H_sz];
+            Scalar f[optimization::f_sz];
+            Scalar Aeq[optimization::Aeq_sz];
+            Scalar beq[optimization::beq_sz];
+            Scalar Aineq[optimization::Aineq_sz];
+            Scalar bineq[optimization::bineq_sz];
+        };
+
+        struct alignas(64) CheckpointHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t record_size;
+            uint32_t scalar_size;
+            uint32_t nu_size;
+            uint32_t site_ids_size;
+            uint32_t s_size;
+            uint32_t design_vector_size;
+        };
+
+        // File layout: CheckpointHeader followed by two slots. Writes alternate between them,
+        // so a process dying mid write leaves the other slot's record complete.
+        template <typename Descriptor>
+        struct CheckpointLayout {
+            using Record = CheckpointRecord<Descriptor>;
+            using Slot = shared_memory::SequenceLockSlot<Record>;
+
+            static_assert(std::is_standard_layout_v<Record>);
+            static constexpr int slot_count = 2;
+            static constexpr size_t size = sizeof(CheckpointHeader) + slot_count * sizeof(Slot);
+
+            static CheckpointHeader header() {
+                return CheckpointHeader{
+                    .magic = kCheckpointMagic,
+                    .version = kCheckpointVersion,
+                    .record_size = sizeof(Record),
+                    .scalar_size = sizeof(typename Descriptor::Scalar),
+                    .nu_size = Descriptor::model::nu_size,
+                    .site_ids_size = Descriptor::model::site_ids_size,
+                    .s_size = Descriptor::optimization::s_size,
+                    .design_vector_size = Descriptor::optimization::design_vector_size,
+                };
+            }
+
+            static bool is_valid(const void* memory, size_t region_size) {
+                if(region_size < size)
+                    return false;
+                const CheckpointHeader* mapped = static_cast<const CheckpointHeader*>(memory);
+                const CheckpointHeader expected = header();
+                return
+                    mapped->magic == expected.magic &&
+                    mapped->version == expected.version &&
+                    mapped->record_size == expected.record_size &&
+                    mapped->scalar_size == expected.scalar_size &&
+                    mapped->nu_size == expected.nu_size &&
+                    mapped->site_ids_size == expected.site_ids_size &&
+                    mapped->s_size == expected.s_size &&
+                    mapped->design_vector_size == expected.design_vector_size;
+            }
+
+            static Slot* slots(void* memory) {
+                return reinterpret_cast<Slot*>(static_cast<char*>(memory) + sizeof(CheckpointHeader));
+            }
+
+            static const Slot* slots(const void* memory) {
+                return reinterpret_cast<const Slot*>(static_cast<const char*>(memory) + sizeof(CheckpointHeader));
+            }
+
+            // Copies the complete record with the highest count: (False if no record is complete)
+            static bool read_latest(const void* memory, Record& record) {
+                int latest = -1;
+                uint64_t latest_count = 0;
+                for(int i = 0; i < slot_count; i++) {
+                    if(slots(memory)[i].read(record) == 0)
+                        continue;
+                    if(latest < 0 || record.count > latest_count) {
+                        latest = i;
+                        latest_count = record.count;
+                    }
+                }
+                if(latest < 0)
+                    return false;
+                return slots(memory)[latest].read(record) != 0;
+            }
+        };
+
+        /*
+            Checkpoint File: Single writer of a memory mapped checkpoint file.
+            write() makes no syscalls. The records live in the page cache, so they survive a crash or restart
+            of the process (not of the machine). Opening a file with a matching layout keeps its records,
+            so a restarted process can restore from and keep writing to the same file.
+        */
+        template <typename Descriptor>
+        class CheckpointFile {
+            using Layout = CheckpointLayout<Descriptor>;
+            using Slot = typename Layout::Slot;
+
+            public:
+                using Record = CheckpointRecord<Descriptor>;
+
+                CheckpointFile() = default;
+                CheckpointFile(const CheckpointFile&) = delete;
+                CheckpointFile& operator=(const CheckpointFile&) = delete;
+                ~CheckpointFile() { std::ignore = close(); }
+
+                absl::Status open(const std::filesystem::path& path) {
+                    if(is_open())
+                        return absl::FailedPreconditionError("Checkpoint file already open.");
+
+                    int fd = ::open(path.c_str(), O_CREAT | O_RDWR, 0644);
+                    if(fd == -1)
+                        return absl::InternalError("Failed to open checkpoint file: " + path.string());
+
+                    struct stat file_stat;
+                    if(fstat(fd, &file_stat) == -1) {
+                        ::close(fd);
+                        return absl::InternalError("Failed to stat checkpoint file: " + path.string());
+                    }
+                    const bool keep_records = static_cast<size_t>(file_stat.st_size) == Layout::size;
+                    if(!keep_records && ftruncate(fd, Layout::size) == -1) {
+                        ::close(fd);
+                        return absl::InternalError("Failed to size checkpoint file: " + path.string());
+                    }
+
+                    void* mapping = mmap(nullptr, Layout::size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                    ::close(fd);
+                    if(mapping == MAP_FAILED)
+                        return absl::InternalError("Failed to map checkpoint file: " + path.string());
+
+                    slots = Layout::slots(mapping);
+                    if(keep_records && Layout::is_valid(mapping, Layout::size)) {
+                        // Continue the checkpoint numbering and drop records torn by a previous writer:
+                        auto latest = std::make_unique<Record>();
+                        count = Layout::read_latest(mapping, *latest) ? latest->count : 0;
+                        for(int i = 0; i < Layout::slot_count; i++) {
+                            if(slots[i].sequence.load(std::memory_order_relaxed) & 1)
+                                slots[i].sequence.store(0, std::memory_order_relaxed);
+                        }
+                    }
+                    else {
+                        // Fault in the pages now instead of on the control thread:
+                        std::memset(mapping, 0, Layout::size);
+                        new (mapping) CheckpointHeader(Layout::header());
+                        count = 0;
+                    }
+
+                    memory = mapping;
+                    return absl::OkStatus();
+                }
+
+                absl::Status close() {
+                    if(!is_open())
+                        return absl::OkStatus();
+
+                    munmap(memory, Layout::size);
+                    memory = nullptr;
+                    slots = nullptr;
+                    return absl::OkStatus();
+                }
+
+                bool is_open() const {
+                    return memory != nullptr;
+                }
+
+                // Overwrites the older slot: (Sets record.count)
+                void write(Record& record) {
+                    record.count = ++count;
+                    slots[record.count % Layout::slot_count].write(record);
+                }
+
+            private:
+                void* memory = nullptr;
+                Slot* slots = nullptr;
+                uint64_t count = 0;
+        };
+
+        // Reads the latest complete record of a checkpoint file:
+        template <typename Descriptor>
+        absl::Status load(const std::filesystem::path& path, CheckpointRecord<Descriptor>& record) {
+            using Layout = CheckpointLayout<Descriptor>;
+
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if(fd == -1)
+                return absl::NotFoundError("Checkpoint file not found: " + path.string());
+
+            struct stat file_stat;
+            if(fstat(fd, &file_stat) == -1 || static_cast<size_t>(file_stat.st_size) < Layout::size) {
+                ::close(fd);
+                return absl::FailedPreconditionError("Checkpoint layout mismatch: " + path.string());
+            }
+
+            void* mapping = mmap(nullptr, Layout::size, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if(mapping == MAP_FAILED)
+                return absl::InternalError("Failed to map checkpoint file: " + path.string());
+
+            absl::Status result;
+            if(!Layout::is_valid(mapping, Layout::size))
+                result = absl::FailedPreconditionError("Checkpoint layout mismatch: " + path.string());
+            else if(!Layout::read_latest(mapping, record))
+                result = absl::NotFoundError("Checkpoint file has no complete checkpoint: " + path.string());
+            munmap(mapping, Layout::size);
+            return result;
+        }
+
+        template <typename Descriptor>
+        void write_state(const containers::State<Descriptor>& state, CheckpointRecord<Descriptor>& record) {
+            using model = typename Descriptor::model;
+            record.state_sequence = state.sequence;
+            record.state_timestamp_ns = state.timestamp_ns;
+            Eigen::Map<Vector<model::nu_size>>(record.motor_position) = state.motor_position;
+            Eigen::Map<Vector<model::nu_size>>(record.motor_velocity) = state.motor_velocity;
+            Eigen::Map<Vector<model::nu_size>>(record.motor_acceleration) = state.motor_acceleration;
+            Eigen::Map<Vector<model::nu_size>>(record.torque_estimate) = state.torque_estimate;
+            Eigen::Map<Vector<4>>(record.body_rotation) = state.body_rotation;
+            Eigen::Map<Vector<3>>(record.linear_body_velocity) = state.linear_body_velocity;
+            Eigen::Map<Vector<3>>(record.angular_body_velocity) = state.angular_body_velocity;
+            Eigen::Map<Vector<3>>(record.linear_body_acceleration) = state.linear_body_acceleration;
+            Eigen::Map<Vector<model::contact_site_ids_size>>(record.contact_mask) = state.contact_mask;
+        }
+
+        template <typename Descriptor>
+        void read_state(const CheckpointRecord<Descriptor>& record, containers::State<Descriptor>& state) {
+            using model = typename Descriptor::model;
+            state.sequence = record.state_sequence;
+            state.timestamp_ns = record.state_timestamp_ns;
+            state.motor_position = Eigen::Map<const Vector<model::nu_size>>(record.motor_position);
+            state.motor_velocity = Eigen::Map<const Vector<model::nu_size>>(record.motor_velocity);
+            state.motor_acceleration = Eigen::Map<const Vector<model::nu_size>>(record.motor_acceleration);
+            state.torque_estimate = Eigen::Map<const Vector<model::nu_size>>(record.torque_estimate);
+            state.body_rotation = Eigen::Map<const Vector<4>>(record.body_rotation);
+            state.linear_body_velocity = Eigen::Map<const Vector<3>>(record.linear_body_velocity);
+            state.angular_body_velocity = Eigen::Map<const Vector<3>>(record.angular_body_velocity);
+            state.linear_body_acceleration = Eigen::Map<const Vector<3>>(record.linear_body_acceleration);
+            state.contact_mask = Eigen::Map<const Vector<model::contact_site_ids_size>>(record.contact_mask);
+        }
+
+        template <typename Descriptor>
+        void write_optimization_data(const containers::OptimizationData<Descriptor>& opt_data, CheckpointRecord<Descriptor>& record) {
+            using OptimizationData = containers::OptimizationData<Descriptor>;
+            Eigen::Map<decltype(OptimizationData::H)>(record.H) = opt_data.H;
+            Eigen::Map<decltype(OptimizationData::f)>(record.f) = opt_data.f;
+            Eigen::Map<decltype(OptimizationData::Aeq)>(record.Aeq) = opt_data.Aeq;
+            Eigen::Map<decltype(OptimizationData::beq)>(record.beq) = opt_data.beq;
+            Eigen::Map<decltype(OptimizationData::Aineq)>(record.Aineq) = opt_data.Aineq;
+            Eigen::Map<decltype(OptimizationData::bineq)>(record.bineq) = opt_data.bineq;
+        }
+
+        template <typename Descriptor>
+        void read_optimization_data(const CheckpointRecord<Descriptor>& record, containers::OptimizationData<Descriptor>& opt_data) {
+            using OptimizationData = containers::OptimizationData<Descriptor>;
+            opt_data.H = Eigen::Map<const decltype(OptimizationData::H)>(record.H);
+            opt_data.f = Eigen::Map<const decltype(OptimizationData::f)>(record.f);
+            opt_data.Aeq = Eigen::Map<const decltype(OptimizationData::Aeq)>(record.Aeq);
+            opt_data.beq = Eigen::Map<const decltype(OptimizationData::beq)>(record.beq);
+            opt_data.Aineq = Eigen::Map<const decltype(OptimizationData::Aineq)>(record.Aineq);
+            opt_data.bineq = Eigen::Map<const decltype(OptimizationData::bineq)>(record.bineq);
+        }
+    }
+}
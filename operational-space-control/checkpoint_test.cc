@@ -0,0 +1,292 @@
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/aliases.h"
+#include "operational-space-control/checkpoint.h"
+#include "operational-space-control/unitree_go2/operational_space_controller.h"
+
+using namespace operational_space_controller;
+using namespace operational_space_controller::aliases;
+using rules_cc::cc::runfiles::Runfiles;
+
+
+/*
+    Checkpoint Tests: A torn slot falls back to the older record, files with a foreign header are rejected,
+    and the first tick after restore_checkpoint() reuses the restored solution without solving.
+*/
+namespace {
+    // Minimal descriptor: (CheckpointRecord only reads these sizes)
+    struct TestDescriptor {
+        using Scalar = double;
+        struct model {
+            static constexpr int nu_size = 2;
+            static constexpr int site_ids_size = 1;
+            static constexpr int contact_site_ids_size = 1;
+        };
+        struct optimization {
+            static constexpr int s_size = 6;
+            static constexpr int design_vector_size = 4;
+            static constexpr int constraint_matrix_rows = 5;
+            static constexpr int H_sz = 16;
+            static constexpr int f_sz = 4;
+            static constexpr int Aeq_sz = 8;
+            static constexpr int beq_sz = 2;
+            static constexpr int Aineq_sz = 4;
+            static constexpr int bineq_sz = 1;
+        };
+    };
+
+    using Record = checkpoint::CheckpointRecord<TestDescriptor>;
+    using Layout = checkpoint::CheckpointLayout<TestDescriptor>;
+    using CheckpointFile = checkpoint::CheckpointFile<TestDescriptor>;
+
+    std::filesystem::path checkpoint_path(const std::string& name) {
+        const std::filesystem::path path = std::filesystem::path(::testing::TempDir()) / (name + "_" + std::to_string(getpid()) + ".osc");
+        std::filesystem::remove(path);
+        return path;
+    }
+
+    void write_records(const std::filesystem::path& path, uint64_t records) {
+        CheckpointFile file;
+        ASSERT_TRUE(file.open(path).ok());
+        auto record = std::make_unique<Record>();
+        for(uint64_t tick = 1; tick <= records; tick++) {
+            *record = Record{};
+            record->tick = tick;
+            record->solution[0] = static_cast<double>(tick);
+            file.write(*record);
+        }
+        ASSERT_TRUE(file.close().ok());
+    }
+
+    // Maps the checkpoint file read / write to corrupt it like a crashed writer or a foreign file would:
+    class MappedFile {
+        public:
+            explicit MappedFile(const std::filesystem::path& path) {
+                int fd = ::open(path.c_str(), O_RDWR);
+                if(fd == -1)
+                    return;
+                void* mapping = mmap(nullptr, Layout::size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                ::close(fd);
+                if(mapping != MAP_FAILED)
+                    memory = mapping;
+            }
+            ~MappedFile() {
+                if(memory)
+                    munmap(memory, Layout::size);
+            }
+
+            checkpoint::CheckpointHeader& header() {
+                return *static_cast<checkpoint::CheckpointHeader*>(memory);
+            }
+
+            Layout::Slot& slot(uint64_t count) {
+                return Layout::slots(memory)[count % Layout::slot_count];
+            }
+
+            void* memory = nullptr;
+    };
+
+    TEST(CheckpointFileTest, LoadsTheLatestRecord) {
+        const std::filesystem::path path = checkpoint_path("checkpoint_latest");
+        write_records(path, 5);
+        auto record = std::make_unique<Record>();
+        ASSERT_TRUE(checkpoint::load<TestDescriptor>(path, *record).ok());
+        EXPECT_EQ(record->count, 5u);
+        EXPECT_EQ(record->tick, 5u);
+        EXPECT_EQ(record->solution[0], 5.0);
+        std::filesystem::remove(path);
+    }
+
+    TEST(CheckpointFileTest, TornSlotFallsBackToTheOlderRecord) {
+        const std::filesystem::path path = checkpoint_path("checkpoint_torn");
+        write_records(path, 4);
+        {
+            // Writer died mid write of record 4: (Odd sequence)
+            MappedFile mapped(path);
+            ASSERT_NE(mapped.memory, nullptr);
+            mapped.slot(4).sequence.fetch_add(1);
+        }
+
+        auto record = std::make_unique<Record>();
+        ASSERT_TRUE(checkpoint::load<TestDescriptor>(path, *record).ok());
+        EXPECT_EQ(record->count, 3u);
+        EXPECT_EQ(record->tick, 3u);
+
+        // A reopened file drops the torn record and continues the numbering after the intact one:
+        {
+            CheckpointFile file;
+            ASSERT_TRUE(file.open(path).ok());
+            auto next = std::make_unique<Record>();
+            next->tick = 10;
+            file.write(*next);
+            EXPECT_EQ(next->count, 4u);
+        }
+        ASSERT_TRUE(checkpoint::load<TestDescriptor>(path, *record).ok());
+        EXPECT_EQ(record->count, 4u);
+        EXPECT_EQ(record->tick, 10u);
+
+        // Both slots torn: (No complete checkpoint)
+        {
+            MappedFile mapped(path);
+            ASSERT_NE(mapped.memory, nullptr);
+            mapped.slot(3).sequence.fetch_add(1);
+            mapped.slot(4).sequence.fetch_add(1);
+        }
+        EXPECT_TRUE(absl::IsNotFound(checkpoint::load<TestDescriptor>(path, *record)));
+        std::filesystem::remove(path);
+    }
+
+    TEST(CheckpointFileTest, RejectsForeignHeaders) {
+        auto record = std::make_unique<Record>();
+        EXPECT_TRUE(absl::IsNotFound(checkpoint::load<TestDescriptor>(checkpoint_path("checkpoint_missing"), *record)));
+
+        const std::filesystem::path path = checkpoint_path("checkpoint_header");
+        write_records(path, 2);
+        {
+            MappedFile mapped(path);
+            ASSERT_NE(mapped.memory, nullptr);
+            mapped.header().magic ^= 1;
+        }
+        EXPECT_TRUE(absl::IsFailedPrecondition(checkpoint::load<TestDescriptor>(path, *record)));
+
+        write_records(path, 2);
+        {
+            MappedFile mapped(path);
+            ASSERT_NE(mapped.memory, nullptr);
+            mapped.header().version = checkpoint::kCheckpointVersion + 1;
+        }
+        EXPECT_TRUE(absl::IsFailedPrecondition(checkpoint::load<TestDescriptor>(path, *record)));
+
+        // Layout of another descriptor:
+        write_records(path, 2);
+        {
+            MappedFile mapped(path);
+            ASSERT_NE(mapped.memory, nullptr);
+            mapped.header().s_size = TestDescriptor::optimization::s_size + 1;
+        }
+        EXPECT_TRUE(absl::IsFailedPrecondition(checkpoint::load<TestDescriptor>(path, *record)));
+
+        // A writer reinitializes a foreign file instead of continuing its records:
+        {
+            CheckpointFile file;
+            ASSERT_TRUE(file.open(path).ok());
+            auto next = std::make_unique<Record>();
+            file.write(*next);
+            EXPECT_EQ(next->count, 1u);
+        }
+        ASSERT_TRUE(checkpoint::load<TestDescriptor>(path, *record).ok());
+        EXPECT_EQ(record->count, 1u);
+
+        std::filesystem::resize_file(path, Layout::size / 2);
+        EXPECT_TRUE(absl::IsFailedPrecondition(checkpoint::load<TestDescriptor>(path, *record)));
+        std::filesystem::remove(path);
+    }
+
+    class HotRestartTest : public ::testing::Test {
+        protected:
+            using Controller = unitree_go2::OperationalSpaceController;
+            using model = unitree_go2::model;
+
+            void SetUp() override {
+                std::string error;
+                std::unique_ptr<Runfiles> runfiles(Runfiles::CreateForTest(&error));
+                ASSERT_NE(runfiles, nullptr) << error;
+                xml_path = runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+                char mj_error[1000];
+                mj_model = mj_loadXML(xml_path.c_str(), nullptr, mj_error, 1000);
+                ASSERT_NE(mj_model, nullptr) << mj_error;
+                mj_data = mj_makeData(mj_model);
+                mj_resetDataKeyframe(mj_model, mj_data, 0);
+                mj_forward(mj_model, mj_data);
+            }
+
+            void TearDown() override {
+                if(mj_data)
+                    mj_deleteData(mj_data);
+                if(mj_model)
+                    mj_deleteModel(mj_model);
+            }
+
+            Controller::State keyframe_state() const {
+                Controller::State state;
+                state.motor_position = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(7, model::nu_size));
+                state.motor_velocity = Vector<model::nu_size>::Zero();
+                state.motor_acceleration = Vector<model::nu_size>::Zero();
+                state.torque_estimate = Vector<model::nu_size>::Zero();
+                state.body_rotation = Eigen::Map<Vector<model::nq_size>>(mj_data->qpos)(Eigen::seqN(3, 4));
+                state.linear_body_velocity = Vector<3>::Zero();
+                state.angular_body_velocity = Vector<3>::Zero();
+                state.linear_body_acceleration = Vector<3>::Zero();
+                state.contact_mask = Vector<model::contact_site_ids_size>::Constant(1.0);
+                return state;
+            }
+
+            std::filesystem::path xml_path;
+            mjModel* mj_model = nullptr;
+            mjData* mj_data = nullptr;
+    };
+
+    TEST_F(HotRestartTest, FirstTickReusesTheRestoredSolution) {
+        const std::filesystem::path path = checkpoint_path("checkpoint_hot_restart");
+        Controller::TaskspaceTargets targets = Controller::TaskspaceTargets::Zero();
+        targets(0, 2) = 1.0;
+
+        // Previous process: (Checkpoints every tick)
+        Vector<unitree_go2::optimization::design_vector_size> stored_solution;
+        Vector<model::nu_size> stored_torque;
+        uint64_t stored_sequence = 0;
+        {
+            Controller controller(xml_path);
+            ASSERT_TRUE(controller.initialize(keyframe_state()).ok());
+            ASSERT_TRUE(controller.initialize_optimization().ok());
+            ASSERT_TRUE(controller.enable_checkpoint(path).ok());
+            controller.update_taskspace_targets(targets);
+            for(int64_t tick = 1; tick <= 3; tick++) {
+                controller.update_state(keyframe_state());
+                ASSERT_TRUE(controller.step(tick * 2'000'000).ok());
+            }
+            stored_sequence = controller.get_stamped_torque_command().state_sequence;
+            stored_solution = controller.get_solution();
+            stored_torque = controller.get_torque_command();
+            ASSERT_TRUE(controller.clean_up().ok());
+        }
+
+        // Restarted process:
+        Controller controller(xml_path);
+        ASSERT_TRUE(controller.initialize(keyframe_state()).ok());
+        ASSERT_TRUE(controller.restore_checkpoint(path).ok());
+        EXPECT_EQ(controller.get_solution(), stored_solution);
+        EXPECT_EQ(controller.get_torque_command(), stored_torque);
+
+        // No new sample: The tick reuses the restored solution instead of solving
+        ASSERT_TRUE(controller.step(4 * 2'000'000).ok());
+        const auto statistics = controller.get_statistics();
+        EXPECT_EQ(statistics.ticks, 1u);
+        EXPECT_EQ(statistics.skipped_solves, 1u);
+        EXPECT_FALSE(statistics.last_update.any());
+        EXPECT_EQ(controller.get_solution(), stored_solution);
+        EXPECT_EQ(controller.get_torque_command(), stored_torque);
+        EXPECT_EQ(controller.get_stamped_torque_command().state_sequence, stored_sequence);
+
+        // A new sample solves warm started from it:
+        controller.update_state(keyframe_state());
+        ASSERT_TRUE(controller.step(5 * 2'000'000).ok());
+        EXPECT_EQ(controller.get_statistics().skipped_solves, 1u);
+        EXPECT_TRUE(controller.clean_up().ok());
+        std::filesystem::remove(path);
+    }
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstdint>
+
+#include "operational-space-control/aliases.h"
+
+using namespace operational_space_controller::aliases;
+
+
+namespace operational_space_controller {
+    namespace containers {
+        // QP blocks recomputed and pushed to OSQP in a tick: (Dependency tracked against the previous tick)
+        //   osc_data   : State changed (Mujoco forward kinematics and OSCData)
+        //   equality   : State changed (Aeq, beq)
+        //   inequality : Friction coefficient changed (Aineq, bineq)
+        //   objective  : State, targets or weights changed (H, f)
+        //   bounds     : Equality, inequality or contact mask changed (lb, ub)
+        struct QPUpdate {
+            bool osc_data = true;
+            bool equality = true;
+            bool inequality = true;
+            bool objective = true;
+            bool bounds = true;
+
+            bool any() const {
+                return osc_data || equality || inequality || objective || bounds;
+            }
+        };
+
+        // Control loop timing statistics: (Stage times and latency of the last tick in microseconds)
+        // state_age_us: Time from the capture of the state used by the last tick (State::timestamp_ns) until its torque command was computed.
+        // solver_failures: Ticks whose OSQP exit code was not optimal.
+        // state_sequence: Sequence number of the state used by the last tick.
+        // dropped_states: State samples overwritten before any tick used them. (Gaps in the consumed sequence numbers)
+        // reused_states: Ticks that ran on the same state sample as the previous tick.
+        // primary_race_wins, secondary_race_wins: Solves won by each instance with the racing solver enabled.
+        // skipped_races: Solves the primary ran alone because the secondary was still winding down from a lost race.
+        // race_blocked_us: Time the last race waited for a cancelled primary to finish its chunk after the secondary won.
+        // skipped_*: Ticks that reused the previous tick's blocks. (last_update: Blocks updated by the last tick)
+        struct ControlLoopStatistics {
+            uint64_t ticks = 0;
+            uint64_t overruns = 0;
+            uint64_t watchdog_ticks = 0;
+            uint64_t solver_failures = 0;
+            double model_stage_us = 0.0;
+            double solver_stage_us = 0.0;
+            double latency_us = 0.0;
+            double max_latency_us = 0.0;
+            double state_age_us = 0.0;
+            double max_state_age_us = 0.0;
+            double mean_state_age_us = 0.0;
+            uint64_t state_sequence = 0;
+            uint64_t dropped_states = 0;
+            uint64_t reused_states = 0;
+            uint64_t primary_race_wins = 0;
+            uint64_t secondary_race_wins = 0;
+            uint64_t skipped_races = 0;
+            double race_blocked_us = 0.0;
+            double max_race_blocked_us = 0.0;
+            QPUpdate last_update;
+            uint64_t skipped_osc_data = 0;
+            uint64_t skipped_equality = 0;
+            uint64_t skipped_inequality = 0;
+            uint64_t skipped_objective = 0;
+            uint64_t skipped_bounds = 0;
+            uint64_t skipped_solves = 0;
+        };
+
+        // OSCData and OptimizationData use Descriptor::Scalar. State and Weights are always double.
+        template <typename Descriptor>
+        struct OSCData {
+            using model = typename Descriptor::model;
+            using optimization = typename Descriptor::optimization;
+            using Scalar = typename Descriptor::Scalar;
+
+            Matrix<model::nv_size, model::nv_size, Scalar> mass_matrix;    
+            Vector<model::nv_size, Scalar> coriolis_matrix;
+            Matrix<model::nv_size, optimization::z_size, Scalar> contact_jacobian;
+            Matrix<optimization::s_size, model::nv_size, Scalar> taskspace_jacobian;
+            Vector<optimization::s_size, Scalar> taskspace_bias;
+            Vector<model::nq_size> previous_q;
+            Vector<model::nv_size> previous_qd;
+        };
+        
+        template <typename Descriptor>
+        struct OptimizationData {
+            using optimization = typename Descriptor::optimization;
+            using Scalar = typename Descriptor::Scalar;
+
+            MatrixColMajor<optimization::H_rows, optimization::H_cols, Scalar> H;
+            Vector<optimization::f_sz, Scalar> f;
+            MatrixColMajor<optimization::Aeq_rows, optimization::Aeq_cols, Scalar> Aeq;
+            Vector<optimization::beq_sz, Scalar> beq;
+            Matrix<optimization::Aineq_rows, optimization::Aineq_cols, Scalar> Aineq;
+            Vector<optimization::bineq_sz, Scalar> bineq;
+        };
+
+        template <typename Descriptor>
+        struct Weights {
+            using optimization = typename Descriptor::optimization;
+
+            Vector<optimization::s_size> task;
+            double torque;
+            double regularization;
+
+            // Default weights from the configuration file:
+            static Weights defaults() {
+                using weights = typename Descriptor::weights;
+                Weights defaults;
+                defaults.task = Eigen::Map<const Vector<optimization::s_size>>(weights::task.data());
+                defaults.torque = weights::torque;
+                defaults.regularization = weights::regularization;
+                return defaults;
+            }
+        };
+
+        // timestamp_ns: Capture time of the sample, steady_clock in nanoseconds (transport::now_ns). 0 is stamped with the time of update_state().
+        // sequence: Increasing sample number from the driver. 0 is numbered by update_state() as the previous sample's sequence + 1.
+        template <typename Descriptor>
+        struct State {
+            using model = typename Descriptor::model;
+
+            int64_t timestamp_ns = 0;
+            uint64_t sequence = 0;
+            Vector<model::nu_size> motor_position;
+            Vector<model::nu_size> motor_velocity;
+            Vector<model::nu_size> motor_acceleration;
+            Vector<model::nu_size> torque_estimate;
+            Vector<4> body_rotation;
+            Vector<3> linear_body_velocity;
+            Vector<3> angular_body_velocity;
+            Vector<3> linear_body_acceleration;
+            Vector<model::contact_site_ids_size> contact_mask;
+        };
+
+        // Torque command stamped with the state it was computed from: (End to end latency is timestamp_ns - state_timestamp_ns)
+        template <typename Descriptor>
+        struct TorqueCommand {
+            using model = typename Descriptor::model;
+
+            Vector<model::nu_size> torque = Vector<model::nu_size>::Zero();
+            uint64_t state_sequence = 0;
+            int64_t state_timestamp_ns = 0;
+            // Compute completion time: (steady_clock in nanoseconds)
+            int64_t timestamp_ns = 0;
+
+            int64_t age_ns() const {
+                return timestamp_ns - state_timestamp_ns;
+            }
+        };
+    }
+}
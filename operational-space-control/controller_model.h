@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "mujoco/mujoco.h"
+
+
+namespace operational_space_controller {
+    namespace controller_model {
+        /*
+            Controller Model: Mujoco model and site/body ids shared read only by any number of controllers.
+                load             : MJCF XML, or a precompiled MJB file (.mjb extension)
+                load_from_buffer : Precompiled MJB already in memory (e.g. read once or embedded in the binary)
+                save / to_buffer : Precompile the model to MJB
+            Ids are resolved once and validated against the Descriptor's constexpr lists and dimensions.
+            Controllers only run kinematics on the model, so one instance can back any number of controllers.
+        */
+        template <typename Descriptor>
+        class ControllerModel {
+            using model = typename Descriptor::model;
+
+            static_assert(model::site_ids_size == model::body_ids_size, "Number of Sites and Bodies must be equal.");
+
+            public:
+                using SharedModel = std::shared_ptr<const ControllerModel>;
+
+                ControllerModel(const ControllerModel&) = delete;
+                ControllerModel& operator=(const ControllerModel&) = delete;
+                ~ControllerModel() {
+                    if(mj_model)
+                        mj_deleteModel(mj_model);
+                }
+
+                static absl::StatusOr<SharedModel> load(const std::filesystem::path& path) {
+                    mjModel* loaded_model = nullptr;
+                    if(path.extension() == ".mjb") {
+                        loaded_model = mj_loadModel(path.c_str(), nullptr);
+                        if(!loaded_model)
+                            return absl::InternalError("Failed to load Mujoco Model: " + path.string());
+                    }
+                    else {
+                        char error[1000];
+                        loaded_model = mj_loadXML(path.c_str(), nullptr, error, 1000);
+                        if(!loaded_model)
+                            return absl::InternalError("Failed to load Mujoco Model: " + std::string(error));
+                    }
+                    return create(loaded_model);
+                }
+
+                static absl::StatusOr<SharedModel> load_from_buffer(const void* buffer, int buffer_size) {
+                    // Mujoco reads MJB buffers through a virtual file system:
+                    mjVFS vfs;
+                    mj_defaultVFS(&vfs);
+                    if(mj_addBufferVFS(&vfs, "model.mjb", buffer, buffer_size) != 0) {
+                        mj_deleteVFS(&vfs);
+                        return absl::InternalError("Failed to add model buffer to the Mujoco VFS.");
+                    }
+                    mjModel* loaded_model = mj_loadModel("model.mjb", &vfs);
+                    mj_deleteVFS(&vfs);
+                    if(!loaded_model)
+                        return absl::InternalError("Failed to load Mujoco Model from buffer.");
+                    return create(loaded_model);
+                }
+
+                absl::Status save(const std::filesystem::path& path) const {
+                    mj_saveModel(mj_model, path.c_str(), nullptr, 0);
+                    if(!std::filesystem::exists(path))
+                        return absl::InternalError("Failed to save Mujoco Model: " + path.string());
+                    return absl::OkStatus();
+                }
+
+                std::vector<uint8_t> to_buffer() const {
+                    std::vector<uint8_t> buffer(mj_sizeModel(mj_model));
+                    mj_saveModel(mj_model, nullptr, buffer.data(), static_cast<int>(buffer.size()));
+                    return buffer;
+                }
+
+                const mjModel* mujoco_model() const {
+                    return mj_model;
+                }
+
+                // Ids in Descriptor::model list order:
+                const std::vector<int>& site_ids() const { return sites; }
+                const std::vector<int>& noncontact_site_ids() const { return noncontact_sites; }
+                const std::vector<int>& contact_site_ids() const { return contact_sites; }
+                const std::vector<int>& body_ids() const { return bodies; }
+
+            private:
+                ControllerModel() = default;
+
+                // Takes ownership of loaded_model:
+                static absl::StatusOr<SharedModel> create(mjModel* loaded_model) {
+                    std::shared_ptr<ControllerModel> controller_model(new ControllerModel());
+                    controller_model->mj_model = loaded_model;
+
+                    // Physics timestep:
+                    loaded_model->opt.timestep = 0.002;
+
+                    absl::Status result = controller_model->resolve_ids();
+                    if(!result.ok())
+                        return result;
+                    return SharedModel(std::move(controller_model));
+                }
+
+                absl::Status resolve_ids() {
+                    if(mj_model->nq != model::nq_size || mj_model->nv != model::nv_size || mj_model->nu != model::nu_size)
+                        return absl::FailedPreconditionError("Mujoco Model dimensions do not match the Descriptor.");
+
+                    absl::Status result;
+                    result.Update(resolve(mjOBJ_SITE, model::site_list, sites));
+                    result.Update(resolve(mjOBJ_SITE, model::noncontact_site_list, noncontact_sites));
+                    result.Update(resolve(mjOBJ_SITE, model::contact_site_list, contact_sites));
+                    result.Update(resolve(mjOBJ_BODY, model::body_list, bodies));
+                    return result;
+                }
+
+                template <typename NameList>
+                absl::Status resolve(mjtObj type, const NameList& names, std::vector<int>& ids) const {
+                    ids.clear();
+                    ids.reserve(names.size());
+                    for(const std::string_view& name : names) {
+                        const std::string name_str(name);
+                        const int id = mj_name2id(mj_model, type, name_str.c_str());
+                        if(id == -1)
+                            return absl::NotFoundError("Not found in Mujoco Model: " + name_str);
+                        ids.push_back(id);
+                    }
+                    return absl::OkStatus();
+                }
+
+                mjModel* mj_model = nullptr;
+                std::vector<int> sites;
+                std::vector<int> noncontact_sites;
+                std::vector<int> contact_sites;
+                std::vector<int> bodies;
+        };
+    }
+}
@@ -5,27 +5,45 @@
 
 #include <Eigen/Dense>
 
-#include "operational-space-control/unitree_go2/autogen/autogen_functions.h"
+// Matches the default integer type of the CasADi generated code:
+#ifndef casadi_int
+#define casadi_int long long int
+#endif
 
 
 namespace {
     typedef void (*func_incref)();
     typedef int (*func_checkout)();
-    typedef int (*eval_func)(const double** args, double** res, casadi_int* iw, double* w, int mem);
+    template <typename Scalar>
+    using eval_func = int (*)(const Scalar** args, Scalar** res, casadi_int* iw, Scalar* w, int mem);
     typedef void (*func_release)(int mem);
     typedef void (*func_decref)();
 }
 
+// Scalar: casadi_real of the generated code (Descriptor::Scalar)
+template <typename Scalar = double>
 struct FunctionOperations {
     func_incref incref;
     func_checkout checkout;
-    eval_func eval;
+    eval_func<Scalar> eval;
     func_release release;
     func_decref decref;
 };
 
-template<size_t sz_args, size_t sz_res, size_t sz_iw, size_t sz_w, int rows, int cols, size_t output_size, size_t N>
+// Generated QP term functions of one ISA variant: (Descriptor::functions::isa_variants)
+template <typename Scalar = double>
+struct FunctionTable {
+    FunctionOperations<Scalar> Aeq;
+    FunctionOperations<Scalar> beq;
+    FunctionOperations<Scalar> Aineq;
+    FunctionOperations<Scalar> bineq;
+    FunctionOperations<Scalar> H;
+    FunctionOperations<Scalar> f;
+};
+
+template<size_t sz_args, size_t sz_res, size_t sz_iw, size_t sz_w, int rows, int cols, size_t output_size, size_t N, typename T = double>
 struct FunctionParams {
+    using Scalar = T;
     static constexpr size_t args_size = sz_args;
     static constexpr size_t res_size = sz_res;
     static constexpr size_t iw_size = sz_iw;
@@ -38,21 +56,22 @@ struct FunctionParams {
 
 // Alias template for the return type
 template<typename Params>
-using ReturnType = Eigen::Matrix<double, Params::matrix_rows, Params::matrix_cols, Eigen::ColMajor>;
+using ReturnType = Eigen::Matrix<typename Params::Scalar, Params::matrix_rows, Params::matrix_cols, Eigen::ColMajor>;
 
 template<typename Params>
 ReturnType<Params> evaluate_function(
-    FunctionOperations& ops, 
-    const std::array<double*, Params::num_args> arguments) {
-    
+    const FunctionOperations<typename Params::Scalar>& ops,
+    const std::array<typename Params::Scalar*, Params::num_args> arguments) {
+    using Scalar = typename Params::Scalar;
+
     // Allocate Work Vectors:
-    const double *args[Params::args_size];
-    double *res[Params::res_size];
+    const Scalar *args[Params::args_size];
+    Scalar *res[Params::res_size];
     casadi_int iw[Params::iw_size];
-    double w[Params::w_size];
+    Scalar w[Params::w_size];
 
     // Place result pointer in the result array:
-    double result[Params::out_size];
+    Scalar result[Params::out_size];
     res[0] = result;
 
     // Increase the reference count:
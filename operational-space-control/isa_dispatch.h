@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include "absl/status/status.h"
+
+#include "operational-space-control/isa_kernels.h"
+
+
+namespace operational_space_controller {
+    namespace isa_dispatch {
+        /*
+            Runtime ISA Dispatch: The hot kernels (Casadi generated functions and isa_kernels) are built once
+            per variant and picked at startup from the CPU features, so one binary runs on mixed CPUs.
+                kBaseline : Compiler default target (SSE2 on x86-64, NEON on aarch64)
+                kAVX2     : AVX2 + FMA (x86-64)
+                kAVX512   : AVX-512 F/DQ/VL (x86-64)
+            The active variant is the best supported one, or OPERATIONAL_SPACE_CONTROL_ISA=<name> if set and supported.
+        */
+        enum class IsaVariant : int {
+            kBaseline = 0,
+            kAVX2 = 1,
+            kAVX512 = 2,
+        };
+        constexpr int kNumIsaVariants = 3;
+
+        inline std::string_view name(IsaVariant variant) {
+            switch(variant) {
+                case IsaVariant::kAVX2: return "avx2";
+                case IsaVariant::kAVX512: return "avx512";
+                default:
+#if defined(__aarch64__)
+                    return "neon";
+#else
+                    return "baseline";
+#endif
+            }
+        }
+
+        inline bool is_supported(IsaVariant variant) {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+            switch(variant) {
+                case IsaVariant::kAVX2:
+                    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+                case IsaVariant::kAVX512:
+                    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl");
+                default:
+                    return true;
+            }
+#else
+            // NEON is part of the aarch64 baseline: (Other variants are x86-64 only)
+            return variant == IsaVariant::kBaseline;
+#endif
+        }
+
+        inline IsaVariant best_supported_variant() {
+            for(int i = kNumIsaVariants - 1; i > 0; i--) {
+                if(is_supported(static_cast<IsaVariant>(i)))
+                    return static_cast<IsaVariant>(i);
+            }
+            return IsaVariant::kBaseline;
+        }
+
+        namespace internal {
+            inline std::atomic<int> active_variant{-1};
+
+            inline IsaVariant startup_variant() {
+                const char* requested = std::getenv("OPERATIONAL_SPACE_CONTROL_ISA");
+                if(requested != nullptr) {
+                    for(int i = 0; i < kNumIsaVariants; i++) {
+                        const IsaVariant variant = static_cast<IsaVariant>(i);
+                        if(name(variant) == requested && is_supported(variant))
+                            return variant;
+                    }
+                }
+                return best_supported_variant();
+            }
+        }
+
+        inline IsaVariant active_variant() {
+            int variant = internal::active_variant.load(std::memory_order_relaxed);
+            if(variant < 0) {
+                variant = static_cast<int>(internal::startup_variant());
+                internal::active_variant.store(variant, std::memory_order_relaxed);
+            }
+            return static_cast<IsaVariant>(variant);
+        }
+
+        // Process wide: (Benchmarks and tests, call before starting control threads)
+        inline absl::Status set_active_variant(IsaVariant variant) {
+            if(!is_supported(variant))
+                return absl::UnavailableError("ISA variant not supported by this CPU: " + std::string(name(variant)));
+            internal::active_variant.store(static_cast<int>(variant), std::memory_order_relaxed);
+            return absl::OkStatus();
+        }
+
+        template <typename T>
+        struct KernelTable {
+            void (*gemv)(const T* A, const T* x, T* y, int rows, int cols);
+            void (*gemv_transpose)(const T* A, const T* x, T* y, int rows, int cols, T alpha);
+            void (*weighted_gram_upper)(const T* A, const T* w, T* C, int rows, int cols, int ldc, T alpha);
+        };
+
+        template <typename T>
+        inline constexpr std::array<KernelTable<T>, kNumIsaVariants> kernel_tables = {{
+            {isa_kernels::baseline::gemv, isa_kernels::baseline::gemv_transpose, isa_kernels::baseline::weighted_gram_upper},
+            {isa_kernels::avx2::gemv, isa_kernels::avx2::gemv_transpose, isa_kernels::avx2::weighted_gram_upper},
+            {isa_kernels::avx512::gemv, isa_kernels::avx512::gemv_transpose, isa_kernels::avx512::weighted_gram_upper},
+        }};
+
+        template <typename T>
+        inline const KernelTable<T>& kernels(IsaVariant variant = active_variant()) {
+            return kernel_tables<T>[static_cast<int>(variant)];
+        }
+    }
+}
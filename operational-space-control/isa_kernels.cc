@@ -0,0 +1,60 @@
+#include "operational-space-control/isa_kernels.h"
+
+// Built once per variant: (See the isa_kernels_* targets)
+#ifndef OPERATIONAL_SPACE_CONTROL_ISA_NAMESPACE
+#error "OPERATIONAL_SPACE_CONTROL_ISA_NAMESPACE must name the ISA variant (baseline, avx2 or avx512)."
+#endif
+
+
+namespace operational_space_controller::isa_kernels::OPERATIONAL_SPACE_CONTROL_ISA_NAMESPACE {
+    namespace {
+        template <typename T>
+        void gemv_impl(const T* __restrict A, const T* __restrict x, T* __restrict y, int rows, int cols) {
+            for(int i = 0; i < rows; i++) {
+                const T* row = A + i * cols;
+                T sum = 0;
+                #pragma omp simd reduction(+:sum)
+                for(int j = 0; j < cols; j++)
+                    sum += row[j] * x[j];
+                y[i] = sum;
+            }
+        }
+
+        template <typename T>
+        void gemv_transpose_impl(const T* __restrict A, const T* __restrict x, T* __restrict y, int rows, int cols, T alpha) {
+            // Row major A: Accumulate scaled rows (contiguous axpy per row)
+            for(int i = 0; i < rows; i++) {
+                const T* row = A + i * cols;
+                const T scale = alpha * x[i];
+                #pragma omp simd
+                for(int j = 0; j < cols; j++)
+                    y[j] += scale * row[j];
+            }
+        }
+
+        template <typename T>
+        void weighted_gram_upper_impl(const T* __restrict A, const T* __restrict w, T* __restrict C, int rows, int cols, int ldc, T alpha) {
+            // Rank one update per row of A: C(0:j, j) += alpha * w_k * a_k(j) * a_k(0:j)
+            for(int k = 0; k < rows; k++) {
+                const T* row = A + k * cols;
+                const T weight = alpha * w[k];
+                for(int j = 0; j < cols; j++) {
+                    const T scale = weight * row[j];
+                    T* column = C + j * ldc;
+                    #pragma omp simd
+                    for(int i = 0; i <= j; i++)
+                        column[i] += scale * row[i];
+                }
+            }
+        }
+    }
+
+    void gemv(const double* A, const double* x, double* y, int rows, int cols) { gemv_impl(A, x, y, rows, cols); }
+    void gemv(const float* A, const float* x, float* y, int rows, int cols) { gemv_impl(A, x, y, rows, cols); }
+
+    void gemv_transpose(const double* A, const double* x, double* y, int rows, int cols, double alpha) { gemv_transpose_impl(A, x, y, rows, cols, alpha); }
+    void gemv_transpose(const float* A, const float* x, float* y, int rows, int cols, float alpha) { gemv_transpose_impl(A, x, y, rows, cols, alpha); }
+
+    void weighted_gram_upper(const double* A, const double* w, double* C, int rows, int cols, int ldc, double alpha) { weighted_gram_upper_impl(A, w, C, rows, cols, ldc, alpha); }
+    void weighted_gram_upper(const float* A, const float* w, float* C, int rows, int cols, int ldc, float alpha) { weighted_gram_upper_impl(A, w, C, rows, cols, ldc, alpha); }
+}
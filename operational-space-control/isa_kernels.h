@@ -0,0 +1,34 @@
+#pragma once
+
+
+/*
+    ISA Kernels: Dense kernels of the control tick, compiled once per instruction set.
+    isa_kernels.cc is built into one library per variant with -DOPERATIONAL_SPACE_CONTROL_ISA_NAMESPACE=<variant>
+    and the matching -m flags. The sources are plain loops without Eigen so that no inline function is shared
+    between objects built for different instruction sets. Select a variant through isa_dispatch.h.
+        gemv                  : y = A x
+        gemv_transpose        : y += alpha * A^T x
+        weighted_gram_upper   : Upper triangle of C += alpha * A^T diag(w) A
+    A is row major (rows x cols). C is column major with leading dimension ldc.
+*/
+#define OPERATIONAL_SPACE_CONTROL_DECLARE_ISA_KERNELS(T) \
+    void gemv(const T* A, const T* x, T* y, int rows, int cols); \
+    void gemv_transpose(const T* A, const T* x, T* y, int rows, int cols, T alpha); \
+    void weighted_gram_upper(const T* A, const T* w, T* C, int rows, int cols, int ldc, T alpha);
+
+namespace operational_space_controller::isa_kernels {
+    namespace baseline {
+        OPERATIONAL_SPACE_CONTROL_DECLARE_ISA_KERNELS(double)
+        OPERATIONAL_SPACE_CONTROL_DECLARE_ISA_KERNELS(float)
+    }
+    namespace avx2 {
+        OPERATIONAL_SPACE_CONTROL_DECLARE_ISA_KERNELS(double)
+        OPERATIONAL_SPACE_CONTROL_DECLARE_ISA_KERNELS(float)
+    }
+    namespace avx512 {
+        OPERATIONAL_SPACE_CONTROL_DECLARE_ISA_KERNELS(double)
+        OPERATIONAL_SPACE_CONTROL_DECLARE_ISA_KERNELS(float)
+    }
+}
+
+#undef OPERATIONAL_SPACE_CONTROL_DECLARE_ISA_KERNELS
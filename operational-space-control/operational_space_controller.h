@@ -0,0 +1,1358 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <semaphore>
+#include <span>
+#include <future>
+#include <iostream>
+#include <cassert>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/log/absl_check.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+#include "Eigen/SparseCore"
+#include "osqp++.h"
+#include "osqp.h"
+
+#include "operational-space-control/utilities.h"
+#include "operational-space-control/function_utilities.h"
+#include "operational-space-control/aliases.h"
+#include "operational-space-control/async_compute.h"
+#include "operational-space-control/checkpoint.h"
+#include "operational-space-control/containers.h"
+#include "operational-space-control/controller_model.h"
+#include "operational-space-control/isa_dispatch.h"
+#include "operational-space-control/osc_data.h"
+#include "operational-space-control/output_stage.h"
+#include "operational-space-control/qp_assembly.h"
+#include "operational-space-control/racing_solver.h"
+#include "operational-space-control/shared_memory_transport.h"
+#include "operational-space-control/target_trajectory.h"
+#include "operational-space-control/telemetry.h"
+#include "operational-space-control/trace.h"
+
+
+using namespace operational_space_controller::aliases;
+
+
+namespace operational_space_controller {
+
+    /*
+        Control Loop Modes:
+            kSequential : Model evaluation, QP assembly and solve run back to back on one thread.
+            kPipelined  : Model evaluation and QP assembly for tick k+1 run on one thread while the
+                          QP for tick k is solved on another. Higher control rates at the cost of
+                          one tick of latency.
+    */
+    enum class ControlLoopMode { kSequential, kPipelined };
+
+    /*
+        Control Loop Triggers:
+            kPeriodic    : Ticks on a fixed control_rate_us schedule.
+            kStateUpdate : Ticks as soon as update_state() publishes a new sample. The periodic
+                           schedule is kept as a watchdog and ticks if no sample arrives within
+                           control_rate_us of the previous tick.
+    */
+    enum class ControlLoopTrigger { kPeriodic, kStateUpdate };
+
+    /*
+        Descriptor: Generated robot description (see autogen.py)
+            Descriptor::model         : Mujoco model dimensions and site/body lists
+            Descriptor::optimization  : QP dimensions
+            Descriptor::functions     : Casadi function table and work sizes
+            Descriptor::weights       : Default objective weights
+            Descriptor::limits        : Actuator limits
+            Descriptor::is_fixed_based
+    */
+    //TODO(jeh15): Refactor all voids with absl::Status
+    template <typename Descriptor>
+    class OperationalSpaceController {
+        public:
+            using model = typename Descriptor::model;
+            using optimization = typename Descriptor::optimization;
+            using functions = typename Descriptor::functions;
+            using limits = typename Descriptor::limits;
+            using Scalar = typename Descriptor::Scalar;
+            using State = containers::State<Descriptor>;
+            using TorqueCommand = containers::TorqueCommand<Descriptor>;
+            using OSCData = containers::OSCData<Descriptor>;
+            using OptimizationData = containers::OptimizationData<Descriptor>;
+            using Weights = containers::Weights<Descriptor>;
+            using ControlLoopStatistics = containers::ControlLoopStatistics;
+            using QPUpdate = containers::QPUpdate;
+            using ControllerModel = controller_model::ControllerModel<Descriptor>;
+            using SharedModel = typename ControllerModel::SharedModel;
+            using TelemetryRecord = telemetry::TelemetryRecord<Descriptor>;
+            using TaskspaceTargets = Matrix<model::site_ids_size, 6>;
+            using TrajectorySegment = target_trajectory::TrajectorySegment<Descriptor>;
+            using TargetWaypoint = target_trajectory::TargetWaypoint<Descriptor>;
+            using OutputStageGains = output_stage::OutputStageGains<Descriptor>;
+            using RacingSettings = racing_solver::RacingSettings;
+            using ComputeResult = async_compute::ComputeResult<Descriptor>;
+            using ComputeCallback = async_compute::ComputeCallback<Descriptor>;
+            using ComputeAwaitable = async_compute::ComputeAwaitable<OperationalSpaceController<Descriptor>>;
+            using CheckpointRecord = checkpoint::CheckpointRecord<Descriptor>;
+            using OptimizationSolution = Vector<optimization::design_vector_size>;
+            using OsqpInstance = osqp::OsqpInstance;
+            using OsqpSolver = osqp::OsqpSolver;
+            using OsqpSettings = osqp::OsqpSettings;
+            using OsqpExitCode = osqp::OsqpExitCode;
+
+            OperationalSpaceController(std::filesystem::path xml_path, int control_rate_us = 2000, OsqpSettings osqp_settings = OsqpSettings()) : 
+                xml_path(xml_path), control_rate_us(control_rate_us), settings(osqp_settings) {}
+            ~OperationalSpaceController() {}
+
+            // Shares an already loaded model: (No parsing or id lookups in initialize)
+            OperationalSpaceController(SharedModel shared_model, int control_rate_us = 2000, OsqpSettings osqp_settings = OsqpSettings()) :
+                shared_model(std::move(shared_model)), control_rate_us(control_rate_us), settings(osqp_settings) {}
+
+            absl::Status initialize(State initial_state) {
+                // Load the model unless one is shared: (MJCF XML or precompiled MJB)
+                if(!shared_model) {
+                    auto loaded_model = ControllerModel::load(xml_path);
+                    if(!loaded_model.ok())
+                        return loaded_model.status();
+                    shared_model = *std::move(loaded_model);
+                }
+
+                mj_model = shared_model->mujoco_model();
+                mj_data = mj_makeData(mj_model);
+
+                // Set initial state to initialize the optimization:
+                set_state(initial_state);
+                initialized = true;
+
+                return absl::OkStatus();
+            }
+
+            absl::Status initialize_optimization() {
+                if(!initialized)
+                    return absl::FailedPreconditionError("Operational Space Controller not initialized.");
+
+                // Initialize mj_data with initial state:
+                update_mj_data();
+
+                // Initialize Optimization:
+                absl::Status result = set_up_optimization();
+                if(!result.ok())
+                    return result;
+
+                optimization_initialized = true;
+
+                return absl::OkStatus();
+            }
+
+            /*
+                Hot Restart: Resumes from the latest checkpoint of a previous controller instead of initialize_optimization().
+                Restores the state, taskspace targets, runtime parameters, torque command, warm start and the QP of the
+                checkpointed tick. OSQP is set up from the restored QP without evaluating it again, and the first tick
+                either reuses the restored solution (no new sample) or solves warm started from it.
+                Call after initialize(). Taskspace trajectories are not checkpointed.
+            */
+            absl::Status restore_checkpoint(const std::filesystem::path& path) {
+                if(!initialized)
+                    return absl::FailedPreconditionError("Operational Space Controller not initialized.");
+                if(optimization_initialized)
+                    return absl::FailedPreconditionError("Optimization already initialized. Restore checkpoints instead of initialize_optimization.");
+
+                absl::Status result = checkpoint::load<Descriptor>(path, checkpoint_record);
+                if(!result.ok())
+                    return result;
+                const CheckpointRecord& record = checkpoint_record;
+
+                auto lock = lock_mutex();
+                checkpoint::read_state(record, state);
+                taskspace_targets = Eigen::Map<const TaskspaceTargets>(record.taskspace_targets);
+                weights.task = Eigen::Map<const Vector<optimization::s_size>>(record.task_weights);
+                weights.torque = record.torque_weight;
+                weights.regularization = record.regularization_weight;
+                friction_coefficient = record.friction_coefficient;
+                solution = Eigen::Map<const Vector<optimization::design_vector_size>>(record.solution);
+                dual_solution = Eigen::Map<const Vector<optimization::constraint_matrix_rows>>(record.dual_solution);
+                exit_code = static_cast<OsqpExitCode>(record.exit_code);
+                command.torque = Eigen::Map<const Vector<model::nu_size>>(record.torque_command);
+                command.state_sequence = record.state_sequence;
+                command.state_timestamp_ns = record.state_timestamp_ns;
+                command.timestamp_ns = record.command_timestamp_ns;
+
+                // OSC Data of the restored state: (Needed when the next tick only changes the targets)
+                update_mj_data();
+                update_osc_data();
+
+                // Restored QP: (Structured assembly caches the parameter dependent blocks first)
+                if constexpr (native_qp_assembly)
+                    structured_assembly.initialize(weights, friction_coefficient, opt_data);
+                update_parameters();
+                checkpoint::read_optimization_data(record, opt_data);
+                state_changed = false;
+                targets_changed = false;
+                previous_contact_mask = state.contact_mask;
+
+                result = initialize_solver(solver, settings, opt_data, state.contact_mask);
+                result.Update(solver.SetWarmStart(solution, dual_solution));
+                if(!result.ok())
+                    return result;
+
+                optimization_initialized = true;
+                return absl::OkStatus();
+            }
+
+            absl::Status initialize_thread(ControlLoopMode mode = ControlLoopMode::kSequential, ControlLoopTrigger trigger = ControlLoopTrigger::kPeriodic) {
+                if(!initialized || !optimization_initialized)
+                    return absl::FailedPreconditionError("Initialization precoditions not met. Initialize controller and optimization before starting control thread.");
+                if(thread_initialized)
+                    return absl::FailedPreconditionError("Control thread or compute executor already started.");
+            
+                control_loop_mode = mode;
+                control_loop_trigger = trigger;
+                if(control_loop_mode == ControlLoopMode::kPipelined) {
+                    thread = std::thread(&OperationalSpaceController<Descriptor>::model_loop, this);
+                    solver_thread = std::thread(&OperationalSpaceController<Descriptor>::solver_loop, this);
+                }
+                else {
+                    thread = std::thread(&OperationalSpaceController<Descriptor>::control_loop, this);
+                }
+                thread_initialized = true;
+                return absl::OkStatus();
+            }
+
+            /*
+                Asynchronous Compute: A controller owned executor thread runs one control tick per submission instead
+                of the control thread's schedule. Submissions run in order. Up to capacity of them can be in flight, so callers
+                can pipeline several and overlap estimation, planning and I/O with the solves.
+                    submit(state, targets, callback) : callback(ComputeResult) on the executor thread
+                    submit(state, targets)           : std::future<ComputeResult>
+                    compute_async(state, targets)    : co_await in a C++20 coroutine
+                Each submission replaces the state and the taskspace targets (stopping any taskspace trajectory) like
+                update_state() and update_taskspace_targets(). Stop with stop_thread(): Queued submissions complete with CancelledError.
+            */
+            absl::Status initialize_executor(size_t capacity = 8) {
+                if(!initialized || !optimization_initialized)
+                    return absl::FailedPreconditionError("Initialize controller and optimization before starting the compute executor.");
+                if(thread_initialized)
+                    return absl::FailedPreconditionError("Control thread or compute executor already started.");
+
+                absl::Status result = compute_executor.start([this](ComputeRequest& request, bool cancelled) {
+                    run_request(request, cancelled);
+                }, capacity);
+                if(!result.ok())
+                    return result;
+                thread_initialized = true;
+                return absl::OkStatus();
+            }
+
+            // Fails with ResourceExhaustedError if capacity submissions are in flight: (The callback is not called then)
+            absl::Status submit(const State& new_state, const TaskspaceTargets& new_taskspace_targets, ComputeCallback callback) {
+                if(!compute_executor.is_running())
+                    return absl::FailedPreconditionError("Compute executor not started. Call initialize_executor first.");
+
+                return compute_executor.post(ComputeRequest{new_state, new_taskspace_targets, std::move(callback)});
+            }
+
+            std::future<ComputeResult> submit(const State& new_state, const TaskspaceTargets& new_taskspace_targets) {
+                auto promise = std::make_shared<std::promise<ComputeResult>>();
+                std::future<ComputeResult> future = promise->get_future();
+                absl::Status submitted = submit(new_state, new_taskspace_targets, [promise](ComputeResult result) {
+                    promise->set_value(std::move(result));
+                });
+                if(!submitted.ok())
+                    promise->set_value(std::move(submitted));
+                return future;
+            }
+
+            ComputeAwaitable compute_async(const State& new_state, const TaskspaceTargets& new_taskspace_targets) {
+                return ComputeAwaitable(*this, new_state, new_taskspace_targets);
+            }
+
+            // Runs one control tick on the calling thread: (Headless simulation in simulated time, without the control thread)
+            absl::Status step() {
+                return step(transport::now_ns());
+            }
+
+            // tick_time_ns: Time at which taskspace trajectories are evaluated (e.g. simulation time)
+            absl::Status step(int64_t tick_time_ns) {
+                if(!initialized || !optimization_initialized)
+                    return absl::FailedPreconditionError("Initialize controller and optimization before stepping.");
+                if(thread_initialized)
+                    return absl::FailedPreconditionError("Cannot step while the control thread owns the controller.");
+
+                auto lock = lock_mutex();
+                run_tick(tick_time_ns);
+                return absl::OkStatus();
+            }
+
+            // Publishes a TelemetryRecord per tick to the POSIX shared memory object name. (Call before initialize_thread)
+            absl::Status enable_telemetry(const std::string& name, uint32_t capacity = 1024) {
+                if(thread_initialized)
+                    return absl::FailedPreconditionError("Telemetry must be enabled before the control thread is started.");
+
+                return telemetry_publisher.open(name, capacity);
+            }
+
+            // Reads State from and writes torque commands to a driver's shared memory transport. (Call before initialize_thread)
+            absl::Status enable_shared_memory_transport(const std::string& name) {
+                if(thread_initialized)
+                    return absl::FailedPreconditionError("Shared memory transport must be enabled before the control thread is started.");
+
+                return shared_memory_transport.attach(name);
+            }
+
+            // High rate output stage between QP solves: (Call before initialize_thread, see get_torque_command(state, time_ns))
+            absl::Status enable_output_stage(const OutputStageGains& gains) {
+                if(thread_initialized)
+                    return absl::FailedPreconditionError("Output stage must be enabled before the control thread is started.");
+
+                absl::Status result = output_stage.set_gains(gains);
+                if(!result.ok())
+                    return result;
+                output_stage_enabled = true;
+                return absl::OkStatus();
+            }
+
+            /*
+                Racing Solver: Every QP is solved by two OSQP instances at once, the controller's warm started instance
+                on the solving thread and a secondary instance (cold started by default) on a dedicated thread.
+                The first optimal result is used and the other solve is cancelled. Trades a spare core for tail latency.
+                (Call after initialize_optimization and before initialize_thread, see ControlLoopStatistics::*_race_wins)
+            */
+            absl::Status enable_racing_solver(const RacingSettings& new_racing_settings = RacingSettings()) {
+                if(!optimization_initialized)
+                    return absl::FailedPreconditionError("Initialize the optimization before enabling the racing solver.");
+                if(thread_initialized)
+                    return absl::FailedPreconditionError("Racing solver must be enabled before the control thread is started.");
+                if(solver_race.is_running())
+                    return absl::FailedPreconditionError("Racing solver already enabled.");
+                if(new_racing_settings.chunk_iterations <= 0)
+                    return absl::InvalidArgumentError("Racing solver chunk iterations must be positive.");
+
+                // Chunked solves continue from the previous chunk's iterate: (Cold starts are explicit zero warm starts)
+                // Forced in settings too, so reinitializations after a sparsity change keep it.
+                racing_settings = new_racing_settings;
+                secondary_settings = racing_settings.secondary_settings;
+                secondary_settings.warm_start = true;
+                settings.warm_start = true;
+                absl::Status result = solver.UpdateWarmStart(true);
+                result.Update(initialize_solver(secondary_solver, secondary_settings, opt_data, state.contact_mask));
+                if(!result.ok())
+                    return result;
+
+                return solver_race.start([this](const std::atomic<bool>& cancelled) {
+                    return solve_secondary(cancelled);
+                }, racing_settings.cpu);
+            }
+
+            /*
+                Checkpoints the controller every interval_ticks ticks to a memory mapped file, see restore_checkpoint().
+                Records alternate between two slots, so a crash mid write keeps the previous checkpoint.
+                Writes are two copies of the record (about 28 KB for the Go2) and no syscalls. (Call before initialize_thread)
+            */
+            absl::Status enable_checkpoint(const std::filesystem::path& path, uint32_t interval_ticks = 1) {
+                if(thread_initialized)
+                    return absl::FailedPreconditionError("Checkpoints must be enabled before the control thread is started.");
+                if(interval_ticks == 0)
+                    return absl::InvalidArgumentError("Checkpoint interval must be positive.");
+
+                checkpoint_interval = interval_ticks;
+                return checkpoint_file.open(path);
+            }
+
+            // Records per tick stage spans and lock waits, written as a Chrome/Perfetto trace when the controller stops. (Call before initialize_thread)
+            absl::Status enable_tracing(const std::filesystem::path& path, size_t capacity = 1 << 18) {
+                if(thread_initialized)
+                    return absl::FailedPreconditionError("Tracing must be enabled before the control thread is started.");
+
+                return tracer.enable(path, capacity);
+            }
+
+            absl::Status stop_thread() {
+                if(!thread_initialized)
+                    return absl::FailedPreconditionError("Operation Space Control Thread not initialized");
+
+                running = false;
+                if(compute_executor.is_running()) {
+                    compute_executor.stop();
+                }
+                else {
+                    state_updated.release();
+                    if(control_loop_mode == ControlLoopMode::kPipelined) {
+                        // Wake both pipeline stages so they observe the stop request:
+                        free_buffers.release();
+                        filled_buffers.release();
+                        solver_thread.join();
+                    }
+                    thread.join();
+                }
+                reset_thread_state();
+                return tracer.write();
+            }
+
+            bool is_initialized() {
+                return initialized;
+            }
+
+            bool is_optimization_initialized() {
+                return optimization_initialized;
+            }
+
+            bool is_thread_initialized() {
+                return thread_initialized;
+            }
+
+            absl::Status clean_up() {
+                if(!initialized)
+                    return absl::FailedPreconditionError("Operational Space Controller not initialized. Nothing to clean up");
+
+                solver_race.stop();
+                mj_deleteData(mj_data);
+                mj_model = nullptr;
+                shared_model.reset();
+
+                absl::Status result = telemetry_publisher.close();
+                result.Update(shared_memory_transport.close());
+                // The checkpoint file is kept for the next process:
+                result.Update(checkpoint_file.close());
+                // Headless runs: (Written by stop_thread otherwise)
+                result.Update(tracer.write());
+                return result;
+            }
+
+            void update_state(const State& new_state) {
+                {
+                    auto lock = lock_mutex();
+                    set_state(new_state);
+                    state_changed = true;
+                }
+                // Wake the control thread: (Futex based, no syscall unless the thread is waiting)
+                if(control_loop_trigger == ControlLoopTrigger::kStateUpdate)
+                    state_updated.release();
+            }
+
+            // Sets the targets directly and stops any taskspace trajectory:
+            void update_taskspace_targets(const TaskspaceTargets& new_taskspace_targets) {
+                auto lock = lock_mutex();
+                taskspace_trajectory.clear();
+                taskspace_targets = new_taskspace_targets;
+                targets_changed = true;
+            }
+
+            /*
+                Taskspace Trajectories: Time stamped targets evaluated by the control thread at every tick.
+                Lock free and allocation free for one planner thread. Times are steady_clock nanoseconds
+                (transport::now_ns), or the tick times passed to step(tick_time_ns) in headless simulation.
+                    update_taskspace_trajectory : Replaces the plan with polynomial or spline segments
+                    update_taskspace_waypoints  : Replaces the plan with linearly interpolated waypoints
+                    append_taskspace_trajectory : Extends the current plan
+                The active segment is kept until the first segment of a new plan starts.
+            */
+            absl::Status update_taskspace_trajectory(std::span<const TrajectorySegment> segments) {
+                return taskspace_trajectory.replace(segments);
+            }
+
+            absl::Status update_taskspace_waypoints(std::span<const TargetWaypoint> waypoints) {
+                return taskspace_trajectory.replace_waypoints(waypoints);
+            }
+
+            absl::Status append_taskspace_trajectory(std::span<const TrajectorySegment> segments) {
+                return taskspace_trajectory.append(segments);
+            }
+
+            /*
+                Runtime Parameters: Objective weights and friction coefficient, applied from the next tick.
+                Only the structured assembly (--config=native_qp_assembly) caches the weight dependent blocks of H between
+                changes. The default Casadi backend takes the weights as an input of the generated H and f, so H, weighted
+                terms included, is re-evaluated on every objective update. (Compare both paths with benchmarks/qp_assembly)
+            */
+            absl::Status update_weights(const Weights& new_weights) {
+                if((new_weights.task.array() < 0.0).any() || new_weights.torque < 0.0 || new_weights.regularization < 0.0)
+                    return absl::InvalidArgumentError("Objective weights must be non-negative.");
+
+                auto lock = lock_mutex();
+                weights = new_weights;
+                parameters_changed = true;
+                return absl::OkStatus();
+            }
+
+            absl::Status update_friction_coefficient(double new_friction_coefficient) {
+                if(new_friction_coefficient < 0.0)
+                    return absl::InvalidArgumentError("Friction coefficient must be non-negative.");
+
+                auto lock = lock_mutex();
+                friction_coefficient = new_friction_coefficient;
+                parameters_changed = true;
+                return absl::OkStatus();
+            }
+
+            Weights get_weights() {
+                auto lock = lock_mutex();
+                return weights;
+            }
+
+            double get_friction_coefficient() {
+                auto lock = lock_mutex();
+                return friction_coefficient;
+            }
+
+            Vector<model::nu_size> get_torque_command() {
+                auto lock = lock_mutex();
+                return command.torque;
+            }
+
+            // Torque command with the sequence and capture time of the state it was computed from and its completion time:
+            TorqueCommand get_stamped_torque_command() {
+                auto lock = lock_mutex();
+                return command;
+            }
+
+            // Output stage torque for a fresh state sampled at time_ns: (Lock free, call at the actuator rate)
+            // Same time base as the state timestamps. Returns the held QP torque if the output stage is disabled or nothing was solved yet.
+            Vector<model::nu_size> get_torque_command(const State& fresh_state, int64_t time_ns) {
+                Vector<model::nu_size> torque;
+                if(output_stage_enabled && output_stage.compute(fresh_state, time_ns, torque))
+                    return torque;
+                return get_torque_command();
+            }
+
+            Vector<optimization::design_vector_size> get_solution() {
+                auto lock = lock_mutex();
+                return solution;
+            }
+
+            ControlLoopStatistics get_statistics() {
+                auto lock = lock_mutex();
+                return statistics;
+            }
+
+            // Instruction set of the generated functions and dense kernels: (Process wide, see isa_dispatch.h)
+            isa_dispatch::IsaVariant get_isa_variant() const {
+                return isa_dispatch::active_variant();
+            }
+
+            private:
+                // Shared Variables: (Inputs: state and taskspace_targets) (Outputs: command)
+                State state;
+                Matrix<model::site_ids_size, 6> taskspace_targets = Matrix<model::site_ids_size, 6>::Zero();
+                TorqueCommand command;
+                // Sequence of the state used by the previous tick: (Dropped and reused sample statistics)
+                uint64_t consumed_state_sequence = 0;
+                bool state_consumed = false;
+                // Runtime Parameters: (Objective weights and friction coefficient)
+                Weights weights = Weights::defaults();
+                double friction_coefficient = optimization::friction_coefficient;
+                bool parameters_changed = true;
+                // Input Change Tracking: (Set by the update functions, consumed by pending_qp_update)
+                bool state_changed = true;
+                bool targets_changed = true;
+                // Taskspace Trajectory: (Producer is the planner thread, consumed with the mutex held)
+                target_trajectory::TargetTrajectory<Descriptor> taskspace_trajectory;
+                TaskspaceTargets trajectory_targets = TaskspaceTargets::Zero();
+                Vector<model::contact_site_ids_size> previous_contact_mask = Vector<model::contact_site_ids_size>::Zero();
+                Vector<optimization::weights_size, Scalar> weights_vector = Vector<optimization::weights_size, Scalar>::Zero();
+                Scalar scalar_friction_coefficient = optimization::friction_coefficient;
+                /* Initialization Flags */
+                bool initialized = false;
+                bool optimization_initialized = false;
+                bool thread_initialized = false;
+                /* Mujoco Variables */
+                // Read only model and resolved ids, may be shared with other controllers:
+                SharedModel shared_model;
+                const mjModel* mj_model = nullptr;
+                mjData* mj_data;
+                std::filesystem::path xml_path;
+                Matrix<model::site_ids_size, 3> points;
+                static constexpr bool is_fixed_based = Descriptor::is_fixed_based;
+                // QP Assembly Backend: (Casadi generated functions by default, build with --config=native_qp_assembly for structured assembly)
+                // Weight dependent terms of H are only cached by the structured assembly, see update_weights.
+#ifdef OPERATIONAL_SPACE_CONTROL_NATIVE_QP_ASSEMBLY
+                static constexpr bool native_qp_assembly = true;
+#else
+                static constexpr bool native_qp_assembly = false;
+#endif
+                // Control Thread:
+                int control_rate_us;
+                std::atomic<bool> running{true};
+                std::mutex mutex;
+                std::thread thread;
+                ControlLoopMode control_loop_mode = ControlLoopMode::kSequential;
+                // Read by update_state() on driver threads, which may publish while initialize_thread() sets it:
+                std::atomic<ControlLoopTrigger> control_loop_trigger{ControlLoopTrigger::kPeriodic};
+                std::counting_semaphore<> state_updated{0};
+                ControlLoopStatistics statistics;
+                // Output Stage: (Optional, see enable_output_stage)
+                output_stage::OutputStage<Descriptor> output_stage;
+                bool output_stage_enabled = false;
+                typename output_stage::OutputStage<Descriptor>::Reference output_reference;
+                // Shared Memory Telemetry: (Optional, see enable_telemetry)
+                telemetry::TelemetryPublisher<Descriptor> telemetry_publisher;
+                TelemetryRecord telemetry_record;
+                // Hot Restart Checkpoints: (Optional, see enable_checkpoint)
+                checkpoint::CheckpointFile<Descriptor> checkpoint_file;
+                CheckpointRecord checkpoint_record;
+                uint32_t checkpoint_interval = 1;
+                // Tracing: (Optional, see enable_tracing)
+                trace::TraceRecorder tracer;
+                // Shared Memory Transport: (Optional, see enable_shared_memory_transport)
+                transport::SharedMemoryTransport<Descriptor> shared_memory_transport;
+                uint64_t transport_state_sequence = 0;
+                int64_t transport_state_timestamp_ns = 0;
+                // Pipelined Mode: (Model stage writes pipeline_buffers[produced % 2], solver stage reads pipeline_buffers[consumed % 2])
+                struct PipelineBuffer {
+                    OptimizationData opt_data;
+                    QPUpdate qp_update;
+                    State state;
+                    TaskspaceTargets taskspace_targets;
+                    int64_t tick_time_ns;
+                    uint64_t transport_state_sequence;
+                    int64_t transport_state_timestamp_ns;
+                    std::chrono::steady_clock::time_point tick_start;
+                    std::chrono::steady_clock::time_point model_stage_end;
+                };
+                std::array<PipelineBuffer, 2> pipeline_buffers;
+                std::counting_semaphore<> free_buffers{2};
+                std::counting_semaphore<> filled_buffers{0};
+                uint64_t produced = 0;
+                uint64_t consumed = 0;
+                std::thread solver_thread;
+                /* OSQP Solver, settings, and matrices */
+                OsqpSolver solver;
+                OsqpSettings settings;
+                OsqpExitCode exit_code = OsqpExitCode::kUnknown;
+                Vector<optimization::design_vector_size> solution = Vector<optimization::design_vector_size>::Zero();
+                Vector<optimization::constraint_matrix_rows> dual_solution = Vector<optimization::constraint_matrix_rows>::Zero();
+                Vector<optimization::design_vector_size, Scalar> design_vector = Vector<optimization::design_vector_size, Scalar>::Zero();
+                const double infinity = OSQP_INFTY;
+                OSCData osc_data;
+                OptimizationData opt_data;
+                qp_assembly::StructuredAssembly<Descriptor> structured_assembly;
+                // Racing Solver: (Optional, see enable_racing_solver)
+                RacingSettings racing_settings;
+                OsqpSolver secondary_solver;
+                OsqpSettings secondary_settings;
+                racing_solver::RaceResult race_result;
+                bool primary_cancelled = false;
+                bool secondary_thread_named = false;
+                // Secondary's copy of the race inputs: (Written by stage_secondary while the secondary is idle)
+                OptimizationData race_opt_data;
+                Vector<model::contact_site_ids_size> race_contact_mask;
+                QPUpdate race_update;
+                Vector<optimization::design_vector_size> race_solution = Vector<optimization::design_vector_size>::Zero();
+                Vector<optimization::constraint_matrix_rows> race_dual_solution = Vector<optimization::constraint_matrix_rows>::Zero();
+                const float big_number = 1e4;
+                // Constraints:
+                MatrixColMajor<optimization::design_vector_size, optimization::design_vector_size> Abox = 
+                    MatrixColMajor<optimization::design_vector_size, optimization::design_vector_size>::Identity();
+                Vector<optimization::dv_size> dv_lb = Vector<optimization::dv_size>::Constant(-infinity);
+                Vector<optimization::dv_size> dv_ub = Vector<optimization::dv_size>::Constant(infinity);
+                Vector<model::nu_size> u_lb = Eigen::Map<const Vector<model::nu_size>>(limits::torque_lower_bound.data());
+                Vector<model::nu_size> u_ub = Eigen::Map<const Vector<model::nu_size>>(limits::torque_upper_bound.data());
+                Vector<optimization::z_size> z_lb = contact_force_bounds(-infinity, 0.0);
+                Vector<optimization::z_size> z_ub = contact_force_bounds(infinity, big_number);
+                Vector<optimization::bineq_sz> bineq_lb = Vector<optimization::bineq_sz>::Constant(-infinity);
+                // Declared last: (Their threads are stopped before the solvers and data they use are destroyed)
+                racing_solver::SolverRace solver_race;
+                // Asynchronous Compute: (Optional, see initialize_executor)
+                using ComputeRequest = async_compute::ComputeRequest<Descriptor>;
+                async_compute::ComputeExecutor<ComputeRequest> compute_executor;
+                bool executor_thread_named = false;
+            
+                // Per contact bounds on the contact forces: [tangential, tangential, normal]
+                static Vector<optimization::z_size> contact_force_bounds(double tangential_bound, double normal_bound) {
+                    Vector<optimization::z_size> bounds;
+                    for(int i = 0; i < model::contact_site_ids_size; i++) {
+                        bounds.segment(3 * i, 3) << tangential_bound, tangential_bound, normal_bound;
+                    }
+                    return bounds;
+                }
+            
+                absl::Status set_up_optimization() {
+                    // Initialize the Optimization: (Everything should be Column Major for OSQP)
+                    // Write constant blocks of the structured QP assembly:
+                    if constexpr (native_qp_assembly)
+                        structured_assembly.initialize(weights, friction_coefficient, opt_data);
+
+                    // Get initial data from initial state: (Evaluates every block, including the constant Aineq and bineq)
+                    update_osc_data();
+                    update_optimization_data(QPUpdate{});
+
+                    // Later ticks only update the blocks whose inputs changed:
+                    state_changed = false;
+                    targets_changed = false;
+                    previous_contact_mask = state.contact_mask;
+
+                    return initialize_solver(solver, settings, opt_data, state.contact_mask);
+                }
+
+                // Initializes the OSQP workspace with every block of the QP:
+                absl::Status initialize_solver(
+                    OsqpSolver& target_solver,
+                    const OsqpSettings& target_settings,
+                    const OptimizationData& opt_data,
+                    const Vector<model::contact_site_ids_size>& contact_mask
+                ) const {
+                    Vector<optimization::bounds_size> lb;
+                    Vector<optimization::bounds_size> ub;
+                    calculate_bounds(opt_data, contact_mask, lb, ub);
+
+                    OsqpInstance instance;
+                    instance.objective_matrix = objective_matrix(opt_data);
+                    instance.objective_vector = opt_data.f.template cast<double>();
+                    instance.constraint_matrix = constraint_matrix(opt_data);
+                    instance.lower_bounds = lb;
+                    instance.upper_bounds = ub;
+
+                    return target_solver.Init(instance, target_settings);
+                }
+
+                Eigen::SparseMatrix<double> objective_matrix(const OptimizationData& opt_data) const {
+                    Eigen::SparseMatrix<double> sparse_H = opt_data.H.template cast<double>().sparseView();
+                    sparse_H.makeCompressed();
+                    return sparse_H;
+                }
+
+                Eigen::SparseMatrix<double> constraint_matrix(const OptimizationData& opt_data) const {
+                    // Concatenate Constraint Matrix:
+                    MatrixColMajor<optimization::constraint_matrix_rows, optimization::constraint_matrix_cols> A;
+                    A << opt_data.Aeq.template cast<double>(), opt_data.Aineq.template cast<double>(), Abox;
+                    Eigen::SparseMatrix<double> sparse_A = A.sparseView();
+                    sparse_A.makeCompressed();
+                    return sparse_A;
+                }
+
+                void calculate_bounds(
+                    const OptimizationData& opt_data,
+                    const Vector<model::contact_site_ids_size>& contact_mask,
+                    Vector<optimization::bounds_size>& lb,
+                    Vector<optimization::bounds_size>& ub
+                ) const {
+                    Vector<optimization::z_size> z_lb_masked = z_lb;
+                    Vector<optimization::z_size> z_ub_masked = z_ub;
+                    for(int i = 0; i < model::contact_site_ids_size; i++) {
+                        z_lb_masked(Eigen::seqN(3 * i, 3)) *= contact_mask(i);
+                        z_ub_masked(Eigen::seqN(3 * i, 3)) *= contact_mask(i);
+                    }
+                    lb << opt_data.beq.template cast<double>(), bineq_lb, dv_lb, u_lb, z_lb_masked;
+                    ub << opt_data.beq.template cast<double>(), opt_data.bineq.template cast<double>(), dv_ub, u_ub, z_ub_masked;
+                }
+
+                void update_mj_data() {
+                    trace::ScopedSpan span(tracer, trace::Span::kMujocoUpdate);
+                    Vector<model::nq_size> qpos = Vector<model::nq_size>::Zero();
+                    Vector<model::nv_size> qvel = Vector<model::nv_size>::Zero();
+                    if constexpr (is_fixed_based) {
+                        qpos = state.motor_position;
+                        qvel = state.motor_velocity;
+                    } 
+                    else {
+                        const Vector<3> zero_vector = {0.0, 0.0, 0.0};
+                        qpos << zero_vector, state.body_rotation, state.motor_position;
+                        qvel << state.linear_body_velocity, state.angular_body_velocity, state.motor_velocity;
+                    }
+
+                    // Update Mujoco Data: (Copied into mj_data's own buffers, osc_data reads qvel after this returns)
+                    mju_copy(mj_data->qpos, qpos.data(), model::nq_size);
+                    mju_copy(mj_data->qvel, qvel.data(), model::nv_size);
+
+                    // Runs steps: 2-12, 12-18:
+                    mj_fwdPosition(mj_model, mj_data);
+                    mj_fwdVelocity(mj_model, mj_data);
+                 
+
+                    // Update Points: (Gathered by site id, in site_list order)
+                    const std::vector<int>& site_ids = shared_model->site_ids();
+                    for(int i = 0; i < model::site_ids_size; i++)
+                        points.row(i) = Eigen::Map<const Vector<3>>(mj_data->site_xpos + 3 * site_ids[i]).transpose();
+                }
+
+                void update_osc_data() {
+                    trace::ScopedSpan span(tracer, trace::Span::kOSCData);
+                    osc_data::update_osc_data<Descriptor>(mj_model, mj_data, points, shared_model->body_ids(), osc_data);
+                }
+    
+                // Must be called with the mutex held: (Returns the blocks whose inputs changed since the last tick and clears the change flags)
+                QPUpdate pending_qp_update() {
+                    QPUpdate update;
+                    update.osc_data = state_changed;
+                    update.equality = state_changed;
+                    update.inequality = parameters_changed;
+                    update.objective = state_changed || targets_changed || parameters_changed;
+                    update.bounds = update.equality || update.inequality || state.contact_mask != previous_contact_mask;
+                    state_changed = false;
+                    targets_changed = false;
+                    previous_contact_mask = state.contact_mask;
+                    return update;
+                }
+
+                void update_parameters() {
+                    weights_vector << weights.task.template cast<Scalar>(), static_cast<Scalar>(weights.torque), static_cast<Scalar>(weights.regularization);
+                    scalar_friction_coefficient = static_cast<Scalar>(friction_coefficient);
+                    if constexpr (native_qp_assembly)
+                        structured_assembly.update_parameters(weights, friction_coefficient, opt_data);
+                    parameters_changed = false;
+                }
+
+                void update_optimization_data(const QPUpdate& update) {
+                    trace::ScopedSpan span(tracer, native_qp_assembly ? trace::Span::kNativeAssembly : trace::Span::kCasadiEvaluation);
+                    // Refresh cached weight and friction dependent terms only when the parameters changed:
+                    if(parameters_changed)
+                        update_parameters();
+
+                    if constexpr (native_qp_assembly) {
+                        // Native Structured QP Assembly:
+                        if(update.equality)
+                            structured_assembly.update_equality(osc_data, design_vector, opt_data);
+                        if(update.inequality)
+                            structured_assembly.update_inequality(design_vector, opt_data);
+                        if(update.objective) {
+                            const Matrix<model::site_ids_size, 6, Scalar> scalar_taskspace_targets = taskspace_targets.template cast<Scalar>();
+                            structured_assembly.update_objective(osc_data, scalar_taskspace_targets, design_vector, opt_data);
+                        }
+                    }
+                    else {
+                        // Evaluate Casadi Functions: (OSCData is converted to Column Major for Casadi Functions)
+                        // Generated functions of the active ISA variant:
+                        const FunctionTable<Scalar>& table = functions::isa_variants[static_cast<int>(isa_dispatch::active_variant())];
+                        if(update.equality) {
+                            auto mass_matrix = matrix_utils::transformMatrix<Scalar, model::nv_size, model::nv_size, matrix_utils::ColumnMajor>(osc_data.mass_matrix.data());
+                            auto coriolis_matrix = matrix_utils::transformMatrix<Scalar, model::nv_size, 1, matrix_utils::ColumnMajor>(osc_data.coriolis_matrix.data());
+                            auto contact_jacobian = matrix_utils::transformMatrix<Scalar, model::nv_size, optimization::z_size, matrix_utils::ColumnMajor>(osc_data.contact_jacobian.data());
+                            opt_data.Aeq = evaluate_function<typename functions::AeqParams>(table.Aeq, {design_vector.data(), mass_matrix.data(), coriolis_matrix.data(), contact_jacobian.data()});
+                            opt_data.beq = evaluate_function<typename functions::beqParams>(table.beq, {design_vector.data(), mass_matrix.data(), coriolis_matrix.data(), contact_jacobian.data()});
+                        }
+                        if(update.inequality) {
+                            opt_data.Aineq = evaluate_function<typename functions::AineqParams>(table.Aineq, {design_vector.data(), &scalar_friction_coefficient});
+                            opt_data.bineq = evaluate_function<typename functions::bineqParams>(table.bineq, {design_vector.data(), &scalar_friction_coefficient});
+                        }
+                        if(update.objective) {
+                            // Taskspace targets in Descriptor::Scalar: (No-op for double descriptors)
+                            const Matrix<model::site_ids_size, 6, Scalar> scalar_taskspace_targets = taskspace_targets.template cast<Scalar>();
+                            auto taskspace_jacobian = matrix_utils::transformMatrix<Scalar, optimization::s_size, model::nv_size, matrix_utils::ColumnMajor>(osc_data.taskspace_jacobian.data());
+                            auto taskspace_bias = matrix_utils::transformMatrix<Scalar, optimization::s_size, 1, matrix_utils::ColumnMajor>(osc_data.taskspace_bias.data());
+                            auto desired_taskspace_ddx = matrix_utils::transformMatrix<Scalar, model::site_ids_size, 6, matrix_utils::ColumnMajor>(scalar_taskspace_targets.data());
+                            opt_data.H = evaluate_function<typename functions::HParams>(table.H, {design_vector.data(), desired_taskspace_ddx.data(), taskspace_jacobian.data(), taskspace_bias.data(), weights_vector.data()});
+                            opt_data.f = evaluate_function<typename functions::fParams>(table.f, {design_vector.data(), desired_taskspace_ddx.data(), taskspace_jacobian.data(), taskspace_bias.data(), weights_vector.data()});
+                        }
+                    }
+                }
+            
+                // Pushes only the changed blocks to OSQP: (A reinitialized workspace is warm started from primal and dual)
+                absl::Status update_optimization(
+                    OsqpSolver& target_solver,
+                    const OsqpSettings& target_settings,
+                    const OptimizationData& opt_data,
+                    const Vector<model::contact_site_ids_size>& contact_mask,
+                    const QPUpdate& update,
+                    const Vector<optimization::design_vector_size>& primal,
+                    const Vector<optimization::constraint_matrix_rows>& dual
+                ) {
+                    trace::ScopedSpan span(tracer, trace::Span::kOsqpUpdate);
+                    const bool constraints_changed = update.equality || update.inequality;
+
+                    // Check if sparisty changed:
+                    absl::Status sparsity_check;
+                    if(update.objective && constraints_changed)
+                        sparsity_check = target_solver.UpdateObjectiveAndConstraintMatrices(objective_matrix(opt_data), constraint_matrix(opt_data));
+                    else if(update.objective)
+                        sparsity_check = target_solver.UpdateObjectiveMatrix(objective_matrix(opt_data));
+                    else if(constraints_changed)
+                        sparsity_check = target_solver.UpdateConstraintMatrix(constraint_matrix(opt_data));
+
+                    absl::Status result;
+                    if(sparsity_check.ok()) {
+                        // Update Internal OSQP workspace:
+                        if(update.objective)
+                            result.Update(target_solver.SetObjectiveVector(opt_data.f.template cast<double>()));
+                        if(update.bounds) {
+                            Vector<optimization::bounds_size> lb;
+                            Vector<optimization::bounds_size> ub;
+                            calculate_bounds(opt_data, contact_mask, lb, ub);
+                            result.Update(target_solver.SetBounds(lb, ub));
+                        }
+                    }
+                    else {
+                        // Reinitalize OSQP workspace:
+                        result.Update(initialize_solver(target_solver, target_settings, opt_data, contact_mask));
+                    
+                        // Setwarmstart:
+                        result.Update(target_solver.SetWarmStart(primal, dual));
+                    }
+
+                    return result;
+                }
+    
+                OsqpExitCode solve() {
+                    trace::ScopedSpan span(tracer, trace::Span::kSolve);
+                    return solver.Solve();
+                }
+
+                // Pushes the changed blocks and solves: (Returns the solver holding the solution used by the tick)
+                const OsqpSolver& update_and_solve(
+                    const OptimizationData& tick_opt_data,
+                    const Vector<model::contact_site_ids_size>& contact_mask,
+                    const QPUpdate& update
+                ) {
+                    if(!solver_race.is_running()) {
+                        // No error handling for now:
+                        std::ignore = update_optimization(solver, settings, tick_opt_data, contact_mask, update, solution, dual_solution);
+                        exit_code = solve();
+                        return solver;
+                    }
+
+                    // Racing Solver: (The secondary solves its own copy of the inputs, so it may lag behind after losing)
+                    race_result = solver_race.run([&]() {
+                        race_opt_data = tick_opt_data;
+                        race_contact_mask = contact_mask;
+                        // A secondary that sat out races missed their updates:
+                        race_update = race_result.raced ? update : QPUpdate{};
+                        race_solution = solution;
+                        race_dual_solution = dual_solution;
+                    }, [&](const std::atomic<bool>& cancelled) {
+                        std::ignore = update_optimization(solver, settings, tick_opt_data, contact_mask, update, solution, dual_solution);
+                        // A cancelled primary continues from the winning solution instead of its partial iterate:
+                        if(primary_cancelled)
+                            std::ignore = solver.SetWarmStart(solution, dual_solution);
+                        trace::ScopedSpan span(tracer, trace::Span::kSolve);
+                        return racing_solver::solve_cancellable(solver, settings.max_iter, racing_settings.chunk_iterations, cancelled);
+                    });
+                    exit_code = race_result.exit_code;
+                    primary_cancelled = race_result.winner == racing_solver::Racer::kSecondary;
+                    return primary_cancelled ? secondary_solver : solver;
+                }
+
+                // Secondary solver thread: (See enable_racing_solver)
+                OsqpExitCode solve_secondary(const std::atomic<bool>& cancelled) {
+                    if(!secondary_thread_named) {
+                        tracer.name_thread("OSC Racing Solver");
+                        secondary_thread_named = true;
+                    }
+                    std::ignore = update_optimization(secondary_solver, secondary_settings, race_opt_data, race_contact_mask, race_update, race_solution, race_dual_solution);
+                    if(racing_settings.cold_start_secondary)
+                        reset_optimization(secondary_solver);
+                    else
+                        std::ignore = secondary_solver.SetWarmStart(race_solution, race_dual_solution);
+
+                    trace::ScopedSpan span(tracer, trace::Span::kSolve);
+                    return racing_solver::solve_cancellable(secondary_solver, secondary_settings.max_iter, racing_settings.chunk_iterations, cancelled);
+                }
+
+                void reset_optimization(OsqpSolver& target_solver) {
+                    // Set Warm Start to Zero:
+                    Vector<optimization::constraint_matrix_cols> primal_vector = Vector<optimization::constraint_matrix_cols>::Zero();
+                    Vector<optimization::constraint_matrix_rows> dual_vector = Vector<optimization::constraint_matrix_rows>::Zero();
+                    std::ignore = target_solver.SetWarmStart(primal_vector, dual_vector);
+                }
+
+                // After the threads have stopped: (initialize_thread or initialize_executor can start them again)
+                void reset_thread_state() {
+                    while(state_updated.try_acquire()) {}
+                    while(free_buffers.try_acquire()) {}
+                    while(filled_buffers.try_acquire()) {}
+                    free_buffers.release(2);
+                    produced = 0;
+                    consumed = 0;
+                    running = true;
+                    thread_initialized = false;
+                }
+
+                // Takes the mutex: (Waits are recorded as lock wait spans when tracing)
+                std::unique_lock<std::mutex> lock_mutex() {
+                    if(!tracer.is_enabled())
+                        return std::unique_lock<std::mutex>(mutex);
+
+                    const int64_t wait_start = trace::now_ns();
+                    std::unique_lock<std::mutex> lock(mutex);
+                    tracer.record(trace::Span::kLockWait, wait_start, trace::now_ns());
+                    return lock;
+                }
+
+                /* Consistent Execution Time: */
+                void control_loop() {
+                    using Clock = std::chrono::steady_clock;
+                    tracer.name_thread("OSC Control");
+                    auto next_time = Clock::now();
+                    // Thread Loop:
+                    while(running) {
+                        // Calculate next execution time first
+                        next_time += std::chrono::microseconds(control_rate_us);
+
+                        /* Lock Guard Scope */
+                        {   
+                            auto lock = lock_mutex();
+                            run_tick(transport::now_ns());
+                        }
+                        // Check for overrun and wait for the next tick
+                        wait_for_next_tick(next_time);
+                    }
+                }
+
+                // Sequential control tick: Must be called with the mutex held.
+                void run_tick(int64_t tick_time_ns) {
+                    using Clock = std::chrono::steady_clock;
+                    trace::ScopedSpan span(tracer, trace::Span::kTick);
+                    auto tick_start = Clock::now();
+                    read_transport_state();
+                    update_sample_statistics();
+                    evaluate_taskspace_trajectory(tick_time_ns);
+                    const QPUpdate update = pending_qp_update();
+                    if(update.osc_data) {
+                        // Update Mujoco Data:
+                        update_mj_data();
+
+                        // Get OSC Data:
+                        update_osc_data();
+                    }
+
+                    // Get Optimization Data:
+                    update_optimization_data(update);
+                    auto solver_stage_start = Clock::now();
+
+                    // Unchanged QP: Reuse the previous solution unless it was not optimal
+                    const bool solved = update.any() || exit_code != OsqpExitCode::kOptimal;
+                    if(solved) {
+                        // Update and Solve Optimization:
+                        const OsqpSolver& result_solver = update_and_solve(opt_data, state.contact_mask, update);
+                        solution = result_solver.primal_solution();
+                        dual_solution = result_solver.dual_solution();
+                        update_race_statistics();
+                    }
+                
+                    // Get torques from QP solution:
+                    update_torque_command(state);
+                    publish_output_reference(state);
+                    update_statistics(tick_start, solver_stage_start, solver_stage_start, Clock::now());
+                    update_qp_update_statistics(update, solved);
+                    publish_telemetry(state, taskspace_targets);
+                    publish_transport_torque(transport_state_sequence, transport_state_timestamp_ns);
+                    write_checkpoint(state, taskspace_targets, opt_data);
+                }
+
+                /* Asynchronous Compute: One tick per submission on the executor thread */
+                void run_request(ComputeRequest& request, bool cancelled) {
+                    if(cancelled) {
+                        request.callback(absl::CancelledError("Compute executor stopped before the submission ran."));
+                        return;
+                    }
+                    if(!executor_thread_named) {
+                        tracer.name_thread("OSC Executor");
+                        executor_thread_named = true;
+                    }
+
+                    TorqueCommand tick_command;
+                    /* Lock Guard Scope */
+                    {
+                        auto lock = lock_mutex();
+                        set_state(request.state);
+                        state_changed = true;
+                        taskspace_trajectory.clear();
+                        taskspace_targets = request.taskspace_targets;
+                        targets_changed = true;
+                        run_tick(transport::now_ns());
+                        tick_command = command;
+                    }
+                    // Outside the lock: (The callback may submit again or query the controller)
+                    request.callback(std::move(tick_command));
+                }
+
+                /* Pipelined Mode: Model Stage (Consistent Execution Time) */
+                void model_loop() {
+                    using Clock = std::chrono::steady_clock;
+                    tracer.name_thread("OSC Model Stage");
+                    auto next_time = Clock::now();
+                    while(running) {
+                        next_time += std::chrono::microseconds(control_rate_us);
+
+                        // Wait for the solver stage to release a buffer:
+                        free_buffers.acquire();
+                        if(!running)
+                            break;
+
+                        PipelineBuffer& buffer = pipeline_buffers[produced % 2];
+                        /* Lock Guard Scope */
+                        {
+                            auto lock = lock_mutex();
+                            trace::ScopedSpan span(tracer, trace::Span::kModelStage);
+                            buffer.tick_start = Clock::now();
+                            buffer.tick_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(buffer.tick_start.time_since_epoch()).count();
+                            read_transport_state();
+                            update_sample_statistics();
+                            evaluate_taskspace_trajectory(buffer.tick_time_ns);
+                            const QPUpdate update = pending_qp_update();
+                            if(update.osc_data) {
+                                update_mj_data();
+                                update_osc_data();
+                            }
+                            update_optimization_data(update);
+                            buffer.opt_data = opt_data;
+                            buffer.qp_update = update;
+                            buffer.state = state;
+                            buffer.taskspace_targets = taskspace_targets;
+                            buffer.transport_state_sequence = transport_state_sequence;
+                            buffer.transport_state_timestamp_ns = transport_state_timestamp_ns;
+                            buffer.model_stage_end = Clock::now();
+                        }
+                        produced++;
+                        filled_buffers.release();
+
+                        wait_for_next_tick(next_time);
+                    }
+                }
+
+                /* Pipelined Mode: Solver Stage (Runs as soon as the model stage hands off a buffer) */
+                void solver_loop() {
+                    using Clock = std::chrono::steady_clock;
+                    tracer.name_thread("OSC Solver Stage");
+                    while(running) {
+                        filled_buffers.acquire();
+                        if(!running)
+                            break;
+
+                        const PipelineBuffer& buffer = pipeline_buffers[consumed % 2];
+                        trace::ScopedSpan span(tracer, trace::Span::kSolverStage);
+                        auto solver_stage_start = Clock::now();
+                        // Unchanged QP: Reuse the previous solution unless it was not optimal
+                        const bool solved = buffer.qp_update.any() || exit_code != OsqpExitCode::kOptimal;
+                        const OsqpSolver* result_solver = nullptr;
+                        if(solved)
+                            result_solver = &update_and_solve(buffer.opt_data, buffer.state.contact_mask, buffer.qp_update);
+
+                        /* Lock Guard Scope */
+                        {
+                            auto lock = lock_mutex();
+                            if(solved) {
+                                solution = result_solver->primal_solution();
+                                dual_solution = result_solver->dual_solution();
+                                update_race_statistics();
+                            }
+                            update_torque_command(buffer.state);
+                            publish_output_reference(buffer.state);
+                            update_statistics(buffer.tick_start, buffer.model_stage_end, solver_stage_start, Clock::now());
+                            update_qp_update_statistics(buffer.qp_update, solved);
+                            publish_telemetry(buffer.state, buffer.taskspace_targets);
+                            publish_transport_torque(buffer.transport_state_sequence, buffer.transport_state_timestamp_ns);
+                            write_checkpoint(buffer.state, buffer.taskspace_targets, buffer.opt_data);
+                        }
+                        consumed++;
+                        free_buffers.release();
+                    }
+                }
+
+                // Must be called with the mutex held: (Stamps the torque with the state it was computed from)
+                void update_torque_command(const State& tick_state) {
+                    command.torque = solution(Eigen::seqN(optimization::dv_idx, optimization::u_size));
+                    command.state_sequence = tick_state.sequence;
+                    command.state_timestamp_ns = tick_state.timestamp_ns;
+                    command.timestamp_ns = transport::now_ns();
+                }
+
+                // Must be called with the mutex held:
+                void update_statistics(
+                    std::chrono::steady_clock::time_point tick_start,
+                    std::chrono::steady_clock::time_point model_stage_end,
+                    std::chrono::steady_clock::time_point solver_stage_start,
+                    std::chrono::steady_clock::time_point tick_end
+                ) {
+                    using Microseconds = std::chrono::duration<double, std::micro>;
+                    statistics.ticks++;
+                    if(exit_code != OsqpExitCode::kOptimal)
+                        statistics.solver_failures++;
+                    statistics.model_stage_us = Microseconds(model_stage_end - tick_start).count();
+                    statistics.solver_stage_us = Microseconds(tick_end - solver_stage_start).count();
+                    statistics.latency_us = Microseconds(tick_end - tick_start).count();
+                    statistics.max_latency_us = std::max(statistics.max_latency_us, statistics.latency_us);
+                    statistics.state_age_us = 1e-3 * command.age_ns();
+                    statistics.max_state_age_us = std::max(statistics.max_state_age_us, statistics.state_age_us);
+                    statistics.mean_state_age_us += (statistics.state_age_us - statistics.mean_state_age_us) / statistics.ticks;
+                    statistics.state_sequence = command.state_sequence;
+                }
+
+                // Must be called with the mutex held:
+                void update_race_statistics() {
+                    if(!solver_race.is_running())
+                        return;
+                    statistics.skipped_races += !race_result.raced;
+                    statistics.primary_race_wins += race_result.raced && race_result.winner == racing_solver::Racer::kPrimary;
+                    statistics.secondary_race_wins += race_result.winner == racing_solver::Racer::kSecondary;
+                    statistics.race_blocked_us = 1e-3 * race_result.blocked_ns;
+                    statistics.max_race_blocked_us = std::max(statistics.max_race_blocked_us, statistics.race_blocked_us);
+                }
+
+                // Must be called with the mutex held: (Compares the tick's state sample with the previous tick's)
+                void update_sample_statistics() {
+                    // Sequence restarts (e.g. a restarted driver) are neither dropped nor reused:
+                    if(state_consumed) {
+                        if(state.sequence == consumed_state_sequence)
+                            statistics.reused_states++;
+                        else if(state.sequence > consumed_state_sequence)
+                            statistics.dropped_states += state.sequence - consumed_state_sequence - 1;
+                    }
+                    consumed_state_sequence = state.sequence;
+                    state_consumed = true;
+                }
+
+                // Must be called with the mutex held: (Unstamped samples get the update time and the next sequence number)
+                void set_state(const State& new_state) {
+                    const uint64_t previous_sequence = state.sequence;
+                    state = new_state;
+                    if(state.timestamp_ns == 0)
+                        state.timestamp_ns = transport::now_ns();
+                    if(state.sequence == 0)
+                        state.sequence = previous_sequence + 1;
+                }
+
+                // Must be called with the mutex held:
+                void update_qp_update_statistics(const QPUpdate& update, bool solved) {
+                    statistics.last_update = update;
+                    statistics.skipped_osc_data += !update.osc_data;
+                    statistics.skipped_equality += !update.equality;
+                    statistics.skipped_inequality += !update.inequality;
+                    statistics.skipped_objective += !update.objective;
+                    statistics.skipped_bounds += !update.bounds;
+                    statistics.skipped_solves += !solved;
+                }
+
+                // Must be called with the mutex held: (Keeps the previous state if no new sample is available)
+                void read_transport_state() {
+                    if(!shared_memory_transport.is_open())
+                        return;
+
+                    int64_t timestamp_ns = 0;
+                    const uint64_t sequence = shared_memory_transport.read_state(state, timestamp_ns);
+                    if(sequence != 0) {
+                        state_changed |= sequence != transport_state_sequence;
+                        transport_state_sequence = sequence;
+                        transport_state_timestamp_ns = timestamp_ns;
+                    }
+                }
+
+                // Must be called with the mutex held: (Keeps the current targets if no trajectory segment has started)
+                void evaluate_taskspace_trajectory(int64_t tick_time_ns) {
+                    if(!taskspace_trajectory.evaluate(tick_time_ns, trajectory_targets))
+                        return;
+                    if(trajectory_targets != taskspace_targets) {
+                        taskspace_targets = trajectory_targets;
+                        targets_changed = true;
+                    }
+                }
+
+                // Must be called with the mutex held: (QP torque and the joint rows of dv, stamped with the capture time of the tick's state)
+                void publish_output_reference(const State& tick_state) {
+                    if(!output_stage_enabled)
+                        return;
+
+                    output_reference.timestamp_ns = tick_state.timestamp_ns;
+                    Eigen::Map<Vector<model::nu_size>>(output_reference.torque) = command.torque;
+                    Eigen::Map<Vector<model::nu_size>>(output_reference.motor_position) = tick_state.motor_position;
+                    Eigen::Map<Vector<model::nu_size>>(output_reference.motor_velocity) = tick_state.motor_velocity;
+                    Eigen::Map<Vector<model::nu_size>>(output_reference.motor_acceleration) =
+                        solution(Eigen::seqN(model::nv_size - model::nu_size, model::nu_size));
+                    output_stage.publish(output_reference);
+                }
+
+                // Must be called with the mutex held:
+                void publish_transport_torque(uint64_t state_sequence, int64_t state_timestamp_ns) {
+                    if(!shared_memory_transport.is_open())
+                        return;
+
+                    shared_memory_transport.publish_torque(command.torque, state_sequence, state_timestamp_ns);
+                }
+
+                // Must be called with the mutex held: (No syscalls, the record is copied into the shared memory ring)
+                void publish_telemetry(const State& tick_state, const TaskspaceTargets& tick_targets) {
+                    if(!telemetry_publisher.is_open())
+                        return;
+
+                    TelemetryRecord& record = telemetry_record;
+                    record.tick = statistics.ticks;
+                    record.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()
+                    ).count();
+                    record.exit_code = static_cast<int32_t>(exit_code);
+                    record.state_sequence = tick_state.sequence;
+                    record.state_timestamp_ns = tick_state.timestamp_ns;
+                    record.model_stage_us = statistics.model_stage_us;
+                    record.solver_stage_us = statistics.solver_stage_us;
+                    record.latency_us = statistics.latency_us;
+                    Eigen::Map<Vector<model::nu_size>>(record.motor_position) = tick_state.motor_position;
+                    Eigen::Map<Vector<model::nu_size>>(record.motor_velocity) = tick_state.motor_velocity;
+                    Eigen::Map<Vector<model::nu_size>>(record.motor_acceleration) = tick_state.motor_acceleration;
+                    Eigen::Map<Vector<model::nu_size>>(record.torque_estimate) = tick_state.torque_estimate;
+                    Eigen::Map<Vector<4>>(record.body_rotation) = tick_state.body_rotation;
+                    Eigen::Map<Vector<3>>(record.linear_body_velocity) = tick_state.linear_body_velocity;
+                    Eigen::Map<Vector<3>>(record.angular_body_velocity) = tick_state.angular_body_velocity;
+                    Eigen::Map<Vector<3>>(record.linear_body_acceleration) = tick_state.linear_body_acceleration;
+                    Eigen::Map<Vector<model::contact_site_ids_size>>(record.contact_mask) = tick_state.contact_mask;
+                    Eigen::Map<TaskspaceTargets>(record.taskspace_targets) = tick_targets;
+                    Eigen::Map<Vector<model::nu_size>>(record.torque_command) = command.torque;
+                    Eigen::Map<Vector<optimization::z_size>>(record.contact_forces) = solution(Eigen::seqN(optimization::u_idx, optimization::z_size));
+                    telemetry_publisher.publish(record);
+                }
+
+                // Must be called with the mutex held: (tick_opt_data is the QP the solution was computed from)
+                void write_checkpoint(const State& tick_state, const TaskspaceTargets& tick_targets, const OptimizationData& tick_opt_data) {
+                    if(!checkpoint_file.is_open() || statistics.ticks % checkpoint_interval != 0)
+                        return;
+
+                    trace::ScopedSpan span(tracer, trace::Span::kCheckpoint);
+                    CheckpointRecord& record = checkpoint_record;
+                    record.tick = statistics.ticks;
+                    record.timestamp_ns = transport::now_ns();
+                    record.exit_code = static_cast<int32_t>(exit_code);
+                    checkpoint::write_state(tick_state, record);
+                    Eigen::Map<TaskspaceTargets>(record.taskspace_targets) = tick_targets;
+                    Eigen::Map<Vector<optimization::s_size>>(record.task_weights) = weights.task;
+                    record.torque_weight = weights.torque;
+                    record.regularization_weight = weights.regularization;
+                    record.friction_coefficient = friction_coefficient;
+                    Eigen::Map<Vector<model::nu_size>>(record.torque_command) = command.torque;
+                    record.command_timestamp_ns = command.timestamp_ns;
+                    Eigen::Map<Vector<optimization::design_vector_size>>(record.solution) = solution;
+                    Eigen::Map<Vector<optimization::constraint_matrix_rows>>(record.dual_solution) = dual_solution;
+                    checkpoint::write_optimization_data(tick_opt_data, record);
+                    checkpoint_file.write(record);
+                }
+
+                void wait_for_next_tick(std::chrono::steady_clock::time_point& next_time) {
+                    if(control_loop_trigger == ControlLoopTrigger::kPeriodic) {
+                        sleep_until_next_tick(next_time);
+                        return;
+                    }
+
+                    // State Update Trigger: Wait for a new sample or fall back to the periodic schedule.
+                    if(!state_updated.try_acquire_until(next_time)) {
+                        auto lock = lock_mutex();
+                        statistics.watchdog_ticks++;
+                    }
+                    // Coalesce samples that arrived during the previous tick into this one:
+                    while(state_updated.try_acquire()) {}
+                    // Watchdog deadline is one period after this tick starts:
+                    next_time = std::chrono::steady_clock::now();
+                }
+
+                void sleep_until_next_tick(std::chrono::steady_clock::time_point& next_time) {
+                    auto now = std::chrono::steady_clock::now();
+                    if (now < next_time) {
+                        std::this_thread::sleep_until(next_time);
+                    } 
+                    else {
+                        // Log overrun
+                        auto overrun = std::chrono::duration_cast<std::chrono::microseconds>(now - next_time);
+                        std::cout << "Operational Space Control Loop Execution Time Exceeded Control Rate: " 
+                                << overrun.count() << "us" << std::endl;
+                        {
+                            auto lock = lock_mutex();
+                            statistics.overruns++;
+                        }
+                        // Reset next execution time to prevent cascading delays
+                        next_time = now;
+                    }
+                }
+    };
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/aliases.h"
+#include "operational-space-control/containers.h"
+#include "operational-space-control/isa_dispatch.h"
+
+using namespace operational_space_controller::aliases;
+
+
+namespace operational_space_controller {
+    namespace osc_data {
+        // Sites with translational and rotational taskspace rows: (Sites without rows are not evaluated)
+        template <int Sites>
+        struct SiteTasks {
+            std::array<bool, Sites> translational{};
+            std::array<bool, Sites> rotational{};
+        };
+
+        template <typename Descriptor>
+        constexpr SiteTasks<Descriptor::model::site_ids_size> make_site_tasks() {
+            using optimization = typename Descriptor::optimization;
+            SiteTasks<Descriptor::model::site_ids_size> site_tasks;
+            for (int i = 0; i < optimization::s_size; i++) {
+                if (optimization::task_components[i] < 3)
+                    site_tasks.translational[optimization::task_sites[i]] = true;
+                else
+                    site_tasks.rotational[optimization::task_sites[i]] = true;
+            }
+            return site_tasks;
+        }
+
+        template <typename Descriptor>
+        inline constexpr SiteTasks<Descriptor::model::site_ids_size> site_tasks = make_site_tasks<Descriptor>();
+
+        /*
+            OSC Data Assembly: Mass matrix, coriolis terms, taskspace and contact Jacobians and taskspace bias
+            from a forward evaluated mjData (mj_fwdPosition and mj_fwdVelocity).
+                points   : World positions of the sites (row i is the point attached to body_ids[i])
+                body_ids : Mujoco body ids in Descriptor::model::body_list order
+            The taskspace Jacobian and bias only hold the taskspace rows kept by the task configuration. (optimization::task_sites)
+        */
+        template <typename Descriptor>
+        void update_osc_data(
+            const mjModel* mj_model,
+            const mjData* mj_data,
+            const Matrix<Descriptor::model::site_ids_size, 3>& points,
+            const std::vector<int>& body_ids,
+            containers::OSCData<Descriptor>& osc_data
+        ) {
+            using model = typename Descriptor::model;
+            using optimization = typename Descriptor::optimization;
+
+            // Mass Matrix:
+            Matrix<model::nv_size, model::nv_size> mass_matrix =
+                Matrix<model::nv_size, model::nv_size>::Zero();
+            mj_fullM(mj_model, mass_matrix.data(), mj_data->qM);
+
+            // Coriolis Matrix:
+            Vector<model::nv_size> coriolis_matrix =
+                Eigen::Map<Vector<model::nv_size>>(mj_data->qfrc_bias);
+
+            // Generalized Positions and Velocities:
+            Vector<model::nq_size> generalized_positions =
+                Eigen::Map<Vector<model::nq_size> >(mj_data->qpos);
+            Vector<model::nv_size> generalized_velocities =
+                Eigen::Map<Vector<model::nv_size>>(mj_data->qvel);
+
+            // Site Jacobians: Translational [jacp; ...] and rotational [jacr; ...] blocks stacked in site order.
+            // Mujoco writes row major (3, NV) blocks, so each site is written directly into its rows of the stacked matrices.
+            // Only the blocks of sites with taskspace rows (and the translational blocks of the contacts) are computed.
+            Matrix<3 * model::site_ids_size, model::nv_size> site_jacp;
+            Matrix<3 * model::site_ids_size, model::nv_size> site_jacr;
+            Matrix<3 * model::site_ids_size, model::nv_size> site_jacp_dot;
+            Matrix<3 * model::site_ids_size, model::nv_size> site_jacr_dot;
+            for (int i = 0; i < model::site_ids_size; i++) {
+                const bool translational_task = site_tasks<Descriptor>.translational[i];
+                const bool rotational_task = site_tasks<Descriptor>.rotational[i];
+                const bool contact = i >= model::noncontact_site_ids_size;
+                if (!translational_task && !rotational_task && !contact)
+                    continue;
+
+                // Calculate Jacobian:
+                mj_jac(
+                    mj_model, mj_data,
+                    translational_task || contact ? site_jacp.data() + 3 * i * model::nv_size : nullptr,
+                    rotational_task ? site_jacr.data() + 3 * i * model::nv_size : nullptr,
+                    points.row(i).data(), body_ids[i]
+                );
+
+                // Calculate Jacobian Dot: (Taskspace rows only)
+                if (translational_task || rotational_task) {
+                    mj_jacDot(
+                        mj_model, mj_data,
+                        translational_task ? site_jacp_dot.data() + 3 * i * model::nv_size : nullptr,
+                        rotational_task ? site_jacr_dot.data() + 3 * i * model::nv_size : nullptr,
+                        points.row(i).data(), body_ids[i]
+                    );
+                }
+            }
+
+            // Taskspace Jacobian and Jacobian Dot: Gather the taskspace rows, [translational rows; rotational rows]
+            Matrix<optimization::s_size, model::nv_size> taskspace_jacobian;
+            Matrix<optimization::s_size, model::nv_size> jacobian_dot;
+            for (int i = 0; i < optimization::s_size; i++) {
+                const int site = optimization::task_sites[i];
+                const int component = optimization::task_components[i];
+                if (component < 3) {
+                    taskspace_jacobian.row(i) = site_jacp.row(3 * site + component);
+                    jacobian_dot.row(i) = site_jacp_dot.row(3 * site + component);
+                }
+                else {
+                    taskspace_jacobian.row(i) = site_jacr.row(3 * site + component - 3);
+                    jacobian_dot.row(i) = site_jacr_dot.row(3 * site + component - 3);
+                }
+            }
+
+            // Calculate Taskspace Bias Acceleration: (Dispatched to the active ISA variant)
+            Vector<optimization::s_size> taskspace_bias = Vector<optimization::s_size>::Zero();
+            isa_dispatch::kernels<double>().gemv(
+                jacobian_dot.data(), generalized_velocities.data(), taskspace_bias.data(),
+                optimization::s_size, model::nv_size
+            );
+
+            // Contact Jacobian: Shape (NV, 3 * num_contacts)
+            // This assumes contact sites are the last sites, so their translational blocks are the last rows of site_jacp.
+            // contact_jacobian = site_jacp[-(3 * contact_site_ids_size):, :].T
+            Matrix<model::nv_size, optimization::z_size> contact_jacobian =
+                site_jacp.template bottomRows<optimization::z_size>().transpose();
+
+            // Assign to OSCData: (Mujoco computes in double, cast to Descriptor::Scalar)
+            using Scalar = typename Descriptor::Scalar;
+            osc_data.mass_matrix = mass_matrix.template cast<Scalar>();
+            osc_data.coriolis_matrix = coriolis_matrix.template cast<Scalar>();
+            osc_data.contact_jacobian = contact_jacobian.template cast<Scalar>();
+            osc_data.taskspace_jacobian = taskspace_jacobian.template cast<Scalar>();
+            osc_data.taskspace_bias = taskspace_bias.template cast<Scalar>();
+            osc_data.previous_q = generalized_positions;
+            osc_data.previous_qd = generalized_velocities;
+        }
+    }
+}
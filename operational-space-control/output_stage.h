@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "absl/status/status.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/aliases.h"
+#include "operational-space-control/containers.h"
+#include "operational-space-control/shared_memory.h"
+
+using namespace operational_space_controller::aliases;
+
+
+namespace operational_space_controller {
+    namespace output_stage {
+        // Joint space reference of one QP solve: (Plain arrays for the sequence lock slot)
+        template <typename Descriptor>
+        struct OutputReference {
+            using model = typename Descriptor::model;
+
+            // Time of the state the QP was solved for: (steady_clock or simulation time in nanoseconds)
+            int64_t timestamp_ns;
+            double torque[model::nu_size];
+            double motor_position[model::nu_size];
+            double motor_velocity[model::nu_size];
+            // Joint accelerations of the QP solution: (Joint rows of dv)
+            double motor_acceleration[model::nu_size];
+        };
+
+        /*
+            Output Stage Gains: Joint space feedback around the QP reference.
+                stiffness, damping     : Per joint position and velocity gains
+                max_extrapolation_s    : The reference is extrapolated with the QP accelerations for at most this long,
+                                         then held (e.g. when a solve is late)
+        */
+        template <typename Descriptor>
+        struct OutputStageGains {
+            using model = typename Descriptor::model;
+
+            Vector<model::nu_size> stiffness = Vector<model::nu_size>::Zero();
+            Vector<model::nu_size> damping = Vector<model::nu_size>::Zero();
+            double max_extrapolation_s = 0.004;
+
+            static OutputStageGains uniform(double stiffness, double damping) {
+                OutputStageGains gains;
+                gains.stiffness.setConstant(stiffness);
+                gains.damping.setConstant(damping);
+                return gains;
+            }
+        };
+
+        /*
+            Output Stage: High rate torque between QP solves.
+                tau = tau_qp + Kp (q_ref(t) - q) + Kd (qd_ref(t) - qd), clamped to the torque limits
+                q_ref(t) = q0 + qd0 dt + 0.5 qdd dt^2,  qd_ref(t) = qd0 + qdd dt,  dt = t - t0
+            (q0, qd0) is the state the QP was solved for and qdd the joint accelerations of its solution,
+            so the feedback term is zero when the joints follow the QP's plan and only corrects deviations
+            that build up between solves.
+            publish() is called by the controller after every solve. compute() is lock free and may be called
+            from any number of threads at any rate.
+        */
+        template <typename Descriptor>
+        class OutputStage {
+            using model = typename Descriptor::model;
+            using limits = typename Descriptor::limits;
+
+            public:
+                using State = containers::State<Descriptor>;
+                using Reference = OutputReference<Descriptor>;
+                using Gains = OutputStageGains<Descriptor>;
+
+                absl::Status set_gains(const Gains& new_gains) {
+                    if((new_gains.stiffness.array() < 0.0).any() || (new_gains.damping.array() < 0.0).any())
+                        return absl::InvalidArgumentError("Output stage gains must be non-negative.");
+                    if(new_gains.max_extrapolation_s < 0.0)
+                        return absl::InvalidArgumentError("Output stage extrapolation horizon must be non-negative.");
+                    gains = new_gains;
+                    max_extrapolation_ns = static_cast<int64_t>(1e9 * new_gains.max_extrapolation_s);
+                    return absl::OkStatus();
+                }
+
+                const Gains& get_gains() const {
+                    return gains;
+                }
+
+                void publish(const Reference& new_reference) {
+                    slot.write(new_reference);
+                }
+
+                // Writes the torque for state sampled at time_ns. Returns false before the first solve.
+                bool compute(const State& state, int64_t time_ns, Vector<model::nu_size>& torque) const {
+                    Reference reference;
+                    if(slot.read(reference) == 0)
+                        return false;
+
+                    const double dt = 1e-9 * std::clamp<int64_t>(time_ns - reference.timestamp_ns, 0, max_extrapolation_ns);
+                    const Eigen::Map<const Vector<model::nu_size>> q0(reference.motor_position);
+                    const Eigen::Map<const Vector<model::nu_size>> qd0(reference.motor_velocity);
+                    const Eigen::Map<const Vector<model::nu_size>> qdd(reference.motor_acceleration);
+                    const Vector<model::nu_size> position_error = q0 + dt * qd0 + (0.5 * dt * dt) * qdd - state.motor_position;
+                    const Vector<model::nu_size> velocity_error = qd0 + dt * qdd - state.motor_velocity;
+
+                    torque = Eigen::Map<const Vector<model::nu_size>>(reference.torque)
+                        + gains.stiffness.cwiseProduct(position_error)
+                        + gains.damping.cwiseProduct(velocity_error);
+                    torque = torque.cwiseMax(torque_lower_bound).cwiseMin(torque_upper_bound);
+                    return true;
+                }
+
+            private:
+                shared_memory::SequenceLockSlot<Reference> slot{};
+                Gains gains;
+                int64_t max_extrapolation_ns = static_cast<int64_t>(1e9 * Gains().max_extrapolation_s);
+                const Vector<model::nu_size> torque_lower_bound = Eigen::Map<const Vector<model::nu_size>>(limits::torque_lower_bound.data());
+                const Vector<model::nu_size> torque_upper_bound = Eigen::Map<const Vector<model::nu_size>>(limits::torque_upper_bound.data());
+        };
+    }
+}
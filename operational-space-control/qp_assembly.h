@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Eigen/Dense"
+
+#include "operational-space-control/aliases.h"
+#include "operational-space-control/containers.h"
+#include "operational-space-control/isa_dispatch.h"
+
+using namespace operational_space_controller::aliases;
+
+
+namespace operational_space_controller {
+    namespace qp_assembly {
+        /*
+            Structured QP Assembly: Native alternative to the Casadi generated QP terms.
+            Writes the QP terms directly from their block structure:
+                Aeq   = [M | -B | -J_contact]               beq   = -(Aeq * q + C)
+                Aineq = Friction pyramid                    bineq = -(Aineq * q)
+                H     = 2 * blkdiag(J^T W J, w_u I, 0) + 2 * w_reg I
+                f     = H * q + 2 * [J^T W (bias - target); 0; 0]
+            Only the upper triangle of H is written (OSQP only reads the upper triangle).
+            Constant blocks are written once in initialize(). Weight and friction dependent blocks
+            are cached and only rewritten by update_parameters() when the parameters change.
+            The equality, inequality and objective blocks can be updated separately when only some inputs changed.
+        */
+        template <typename Descriptor>
+        class StructuredAssembly {
+            using model = typename Descriptor::model;
+            using optimization = typename Descriptor::optimization;
+            using Weights = containers::Weights<Descriptor>;
+            using OSCData = containers::OSCData<Descriptor>;
+            using OptimizationData = containers::OptimizationData<Descriptor>;
+            using Scalar = typename Descriptor::Scalar;
+
+            public:
+                // Writes the constant blocks of Aeq and the parameter dependent blocks of Aineq and H:
+                void initialize(const Weights& weights, double friction_coefficient, OptimizationData& opt_data) {
+                    // Aeq: -B Block
+                    opt_data.Aeq.setZero();
+                    opt_data.Aeq.template block<model::nu_size, model::nu_size>(model::nv_size - model::nu_size, optimization::dv_idx) =
+                        -Matrix<model::nu_size, model::nu_size, Scalar>::Identity();
+
+                    opt_data.Aineq.setZero();
+                    opt_data.H.setZero();
+                    update_parameters(weights, friction_coefficient, opt_data);
+                }
+
+                // Rewrites the weight and friction dependent blocks:
+                void update_parameters(const Weights& weights, double friction_coefficient, OptimizationData& opt_data) {
+                    const Scalar mu = static_cast<Scalar>(friction_coefficient);
+                    task_weights = weights.task.template cast<Scalar>();
+                    regularization = static_cast<Scalar>(weights.regularization);
+
+                    // Aineq: |f_x| + |f_y| <= mu * f_z for each contact
+                    for(int i = 0; i < model::contact_site_ids_size; i++) {
+                        opt_data.Aineq.template block<4, 3>(4 * i, optimization::u_idx + 3 * i) <<
+                             1,  1, -mu,
+                            -1,  1, -mu,
+                             1, -1, -mu,
+                            -1, -1, -mu;
+                    }
+
+                    // H: Diagonal torque and regularization weights
+                    opt_data.H.diagonal().setConstant(2 * regularization);
+                    opt_data.H.diagonal().template segment<optimization::u_size>(optimization::dv_idx).array() += static_cast<Scalar>(2.0 * weights.torque);
+                }
+
+                // Writes all state and target dependent blocks:
+                void update(
+                    const OSCData& osc_data,
+                    const Matrix<model::site_ids_size, 6, Scalar>& taskspace_targets,
+                    const Vector<optimization::design_vector_size, Scalar>& design_vector,
+                    OptimizationData& opt_data
+                ) const {
+                    update_equality(osc_data, design_vector, opt_data);
+                    update_inequality(design_vector, opt_data);
+                    update_objective(osc_data, taskspace_targets, design_vector, opt_data);
+                }
+
+                // Aeq and beq: (Depend on the dynamics only)
+                void update_equality(
+                    const OSCData& osc_data,
+                    const Vector<optimization::design_vector_size, Scalar>& design_vector,
+                    OptimizationData& opt_data
+                ) const {
+                    opt_data.Aeq.template leftCols<optimization::dv_size>() = osc_data.mass_matrix;
+                    opt_data.Aeq.template rightCols<optimization::z_size>() = -osc_data.contact_jacobian;
+                    opt_data.beq.noalias() = -opt_data.Aeq * design_vector;
+                    opt_data.beq -= osc_data.coriolis_matrix;
+                }
+
+                // bineq: (Depends on the friction coefficient only, call after update_parameters)
+                void update_inequality(
+                    const Vector<optimization::design_vector_size, Scalar>& design_vector,
+                    OptimizationData& opt_data
+                ) const {
+                    opt_data.bineq.noalias() = -opt_data.Aineq * design_vector;
+                }
+
+                // H and f: (Depend on the taskspace Jacobian and bias, the targets and the weights)
+                void update_objective(
+                    const OSCData& osc_data,
+                    const Matrix<model::site_ids_size, 6, Scalar>& taskspace_targets,
+                    const Vector<optimization::design_vector_size, Scalar>& design_vector,
+                    OptimizationData& opt_data
+                ) const {
+                    // Hessian: Upper triangle of the dv block (J^T W J dispatched to the active ISA variant)
+                    const auto& kernels = isa_dispatch::kernels<Scalar>();
+                    auto H_dv = opt_data.H.template topLeftCorner<optimization::dv_size, optimization::dv_size>();
+                    H_dv.template triangularView<Eigen::StrictlyUpper>().setZero();
+                    H_dv.diagonal().setConstant(2 * regularization);
+                    kernels.weighted_gram_upper(
+                        osc_data.taskspace_jacobian.data(), task_weights.data(), opt_data.H.data(),
+                        optimization::s_size, model::nv_size, optimization::H_rows, Scalar(2)
+                    );
+
+                    // Gradient:
+                    Vector<optimization::s_size, Scalar> task_error = osc_data.taskspace_bias;
+                    for(int i = 0; i < optimization::s_size; i++)
+                        task_error(i) -= taskspace_targets(optimization::task_sites[i], optimization::task_components[i]);
+                    opt_data.f.noalias() = opt_data.H.template selfadjointView<Eigen::Upper>() * design_vector;
+                    const Vector<optimization::s_size, Scalar> weighted_error = task_weights.cwiseProduct(task_error);
+                    kernels.gemv_transpose(
+                        osc_data.taskspace_jacobian.data(), weighted_error.data(), opt_data.f.data(),
+                        optimization::s_size, model::nv_size, Scalar(2)
+                    );
+                }
+
+            private:
+                Vector<optimization::s_size, Scalar> task_weights = Vector<optimization::s_size, Scalar>::Zero();
+                Scalar regularization = 0;
+        };
+    }
+}
@@ -0,0 +1,175 @@
+#include <filesystem>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+#include "mujoco/mujoco.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/utilities.h"
+#include "operational-space-control/function_utilities.h"
+#include "operational-space-control/aliases.h"
+#include "operational-space-control/containers.h"
+#include "operational-space-control/isa_dispatch.h"
+#include "operational-space-control/osc_data.h"
+#include "operational-space-control/qp_assembly.h"
+#include "operational-space-control/unitree_go2/autogen/autogen_defines.h"
+#include "operational-space-control/unitree_go2/autogen/float/autogen_defines.h"
+
+using namespace operational_space_controller;
+using namespace operational_space_controller::aliases;
+using rules_cc::cc::runfiles::Runfiles;
+
+
+/*
+    Structured QP Assembly Test: StructuredAssembly against the generated Casadi functions on the Go2 keyframe,
+    for the double and single precision descriptors. H is compared on its upper triangle, the part OSQP reads.
+*/
+namespace {
+    struct Keyframe {
+        mjModel* mj_model = nullptr;
+        mjData* mj_data = nullptr;
+    };
+
+    // Go2 keyframe after mj_fwdPosition and mj_fwdVelocity: (Loaded once per test binary)
+    const Keyframe& keyframe() {
+        static const Keyframe go2 = [] {
+            Keyframe go2;
+            std::string error;
+            std::unique_ptr<Runfiles> runfiles(Runfiles::CreateForTest(&error));
+            if(!runfiles)
+                return go2;
+            std::filesystem::path xml_path = runfiles->Rlocation("mujoco-models/models/unitree_go2/go2.xml");
+            char mj_error[1000];
+            go2.mj_model = mj_loadXML(xml_path.c_str(), nullptr, mj_error, 1000);
+            if(!go2.mj_model)
+                return go2;
+            go2.mj_data = mj_makeData(go2.mj_model);
+            mj_resetDataKeyframe(go2.mj_model, go2.mj_data, 0);
+            mj_fwdPosition(go2.mj_model, go2.mj_data);
+            mj_fwdVelocity(go2.mj_model, go2.mj_data);
+            return go2;
+        }();
+        return go2;
+    }
+
+    template <typename Descriptor>
+    class QPAssemblyTest : public ::testing::Test {
+        protected:
+            using model = typename Descriptor::model;
+            using optimization = typename Descriptor::optimization;
+            using functions = typename Descriptor::functions;
+            using Scalar = typename Descriptor::Scalar;
+            using OSCData = containers::OSCData<Descriptor>;
+            using OptimizationData = containers::OptimizationData<Descriptor>;
+            using Weights = containers::Weights<Descriptor>;
+
+            void SetUp() override {
+                const Keyframe& go2 = keyframe();
+                ASSERT_NE(go2.mj_data, nullptr) << "Failed to load the Go2 keyframe.";
+
+                std::vector<int> body_ids;
+                for(const std::string_view& body : model::body_list) {
+                    const int id = mj_name2id(go2.mj_model, mjOBJ_BODY, std::string(body).c_str());
+                    ASSERT_NE(id, -1) << "Body not found: " << body;
+                    body_ids.push_back(id);
+                }
+                const Matrix<model::site_ids_size, 3> points = Eigen::Map<Matrix<model::site_ids_size, 3>>(go2.mj_data->site_xpos);
+                osc_data::update_osc_data<Descriptor>(go2.mj_model, go2.mj_data, points, body_ids, osc_data);
+
+                // Fixed pseudo-random design vector and targets: (Keeps beq and f away from zero)
+                std::srand(0);
+                taskspace_targets = 10 * Matrix<model::site_ids_size, 6, Scalar>::Random();
+                design_vector = Vector<optimization::design_vector_size, Scalar>::Random();
+            }
+
+            // Casadi generated functions of the baseline variant: (Same arguments as OperationalSpaceController::update_optimization_data)
+            void casadi_assembly(OptimizationData& opt_data) {
+                const FunctionTable<Scalar>& table = functions::isa_variants[static_cast<int>(isa_dispatch::IsaVariant::kBaseline)];
+                Vector<optimization::weights_size, Scalar> weights_vector;
+                weights_vector << weights.task.template cast<Scalar>(), static_cast<Scalar>(weights.torque), static_cast<Scalar>(weights.regularization);
+                Scalar scalar_friction_coefficient = static_cast<Scalar>(friction_coefficient);
+
+                auto mass_matrix = matrix_utils::transformMatrix<Scalar, model::nv_size, model::nv_size, matrix_utils::ColumnMajor>(osc_data.mass_matrix.data());
+                auto coriolis_matrix = matrix_utils::transformMatrix<Scalar, model::nv_size, 1, matrix_utils::ColumnMajor>(osc_data.coriolis_matrix.data());
+                auto contact_jacobian = matrix_utils::transformMatrix<Scalar, model::nv_size, optimization::z_size, matrix_utils::ColumnMajor>(osc_data.contact_jacobian.data());
+                auto taskspace_jacobian = matrix_utils::transformMatrix<Scalar, optimization::s_size, model::nv_size, matrix_utils::ColumnMajor>(osc_data.taskspace_jacobian.data());
+                auto taskspace_bias = matrix_utils::transformMatrix<Scalar, optimization::s_size, 1, matrix_utils::ColumnMajor>(osc_data.taskspace_bias.data());
+                auto desired_taskspace_ddx = matrix_utils::transformMatrix<Scalar, model::site_ids_size, 6, matrix_utils::ColumnMajor>(taskspace_targets.data());
+
+                opt_data.Aeq = evaluate_function<typename functions::AeqParams>(table.Aeq, {design_vector.data(), mass_matrix.data(), coriolis_matrix.data(), contact_jacobian.data()});
+                opt_data.beq = evaluate_function<typename functions::beqParams>(table.beq, {design_vector.data(), mass_matrix.data(), coriolis_matrix.data(), contact_jacobian.data()});
+                opt_data.Aineq = evaluate_function<typename functions::AineqParams>(table.Aineq, {design_vector.data(), &scalar_friction_coefficient});
+                opt_data.bineq = evaluate_function<typename functions::bineqParams>(table.bineq, {design_vector.data(), &scalar_friction_coefficient});
+                opt_data.H = evaluate_function<typename functions::HParams>(table.H, {design_vector.data(), desired_taskspace_ddx.data(), taskspace_jacobian.data(), taskspace_bias.data(), weights_vector.data()});
+                opt_data.f = evaluate_function<typename functions::fParams>(table.f, {design_vector.data(), desired_taskspace_ddx.data(), taskspace_jacobian.data(), taskspace_bias.data(), weights_vector.data()});
+            }
+
+            // Max absolute difference relative to the magnitude of the Casadi term: (Accumulation order differs between backends)
+            template <typename CasadiTerm, typename NativeTerm>
+            void expect_near(const CasadiTerm& casadi, const NativeTerm& native, const char* term) {
+                const double scale = 1.0 + casadi.template cast<double>().cwiseAbs().maxCoeff();
+                const double tolerance = 1e3 * std::numeric_limits<Scalar>::epsilon() * scale;
+                EXPECT_LE((casadi.template cast<double>() - native.template cast<double>()).cwiseAbs().maxCoeff(), tolerance) << term;
+            }
+
+            OSCData osc_data;
+            Matrix<model::site_ids_size, 6, Scalar> taskspace_targets;
+            Vector<optimization::design_vector_size, Scalar> design_vector;
+            Weights weights = Weights::defaults();
+            double friction_coefficient = optimization::friction_coefficient;
+    };
+
+    using Descriptors = ::testing::Types<unitree_go2::Descriptor, unitree_go2_float::Descriptor>;
+    TYPED_TEST_SUITE(QPAssemblyTest, Descriptors);
+
+    TYPED_TEST(QPAssemblyTest, MatchesCasadiFunctions) {
+        using optimization = typename TestFixture::optimization;
+        typename TestFixture::OptimizationData casadi_data;
+        typename TestFixture::OptimizationData native_data;
+        qp_assembly::StructuredAssembly<TypeParam> structured_assembly;
+        structured_assembly.initialize(this->weights, this->friction_coefficient, native_data);
+        structured_assembly.update(this->osc_data, this->taskspace_targets, this->design_vector, native_data);
+        this->casadi_assembly(casadi_data);
+
+        this->expect_near(casadi_data.Aeq, native_data.Aeq, "Aeq");
+        this->expect_near(casadi_data.beq, native_data.beq, "beq");
+        this->expect_near(casadi_data.Aineq, native_data.Aineq, "Aineq");
+        this->expect_near(casadi_data.bineq, native_data.bineq, "bineq");
+        using UpperH = MatrixColMajor<optimization::H_rows, optimization::H_cols, typename TestFixture::Scalar>;
+        const UpperH H_casadi = casadi_data.H.template triangularView<Eigen::Upper>();
+        const UpperH H_native = native_data.H.template triangularView<Eigen::Upper>();
+        this->expect_near(H_casadi, H_native, "H");
+        this->expect_near(casadi_data.f, native_data.f, "f");
+    }
+
+    // Incremental updates after a parameter change match a full Casadi evaluation:
+    TYPED_TEST(QPAssemblyTest, MatchesCasadiFunctionsAfterParameterUpdate) {
+        using optimization = typename TestFixture::optimization;
+        typename TestFixture::OptimizationData casadi_data;
+        typename TestFixture::OptimizationData native_data;
+        qp_assembly::StructuredAssembly<TypeParam> structured_assembly;
+        structured_assembly.initialize(this->weights, this->friction_coefficient, native_data);
+        structured_assembly.update(this->osc_data, this->taskspace_targets, this->design_vector, native_data);
+
+        this->weights.task *= 2.0;
+        this->weights.torque *= 0.5;
+        this->friction_coefficient = 0.4;
+        structured_assembly.update_parameters(this->weights, this->friction_coefficient, native_data);
+        structured_assembly.update(this->osc_data, this->taskspace_targets, this->design_vector, native_data);
+        this->casadi_assembly(casadi_data);
+
+        this->expect_near(casadi_data.Aineq, native_data.Aineq, "Aineq");
+        this->expect_near(casadi_data.bineq, native_data.bineq, "bineq");
+        using UpperH = MatrixColMajor<optimization::H_rows, optimization::H_cols, typename TestFixture::Scalar>;
+        const UpperH H_casadi = casadi_data.H.template triangularView<Eigen::Upper>();
+        const UpperH H_native = native_data.H.template triangularView<Eigen::Upper>();
+        this->expect_near(H_casadi, H_native, "H");
+        this->expect_near(casadi_data.f, native_data.f, "f");
+    }
+}
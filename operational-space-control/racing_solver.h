@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <semaphore>
+#include <string>
+#include <thread>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "absl/status/status.h"
+#include "osqp++.h"
+
+
+namespace operational_space_controller {
+    namespace racing_solver {
+        // Winner of a race: (kNone if neither result was acceptable)
+        enum class Racer : uint8_t { kNone, kPrimary, kSecondary };
+
+        inline const char* name(Racer racer) {
+            switch(racer) {
+                case Racer::kNone: return "none";
+                case Racer::kPrimary: return "primary";
+                case Racer::kSecondary: return "secondary";
+            }
+            return "unknown";
+        }
+
+        /*
+            Racing Settings:
+                secondary_settings   : OSQP settings of the secondary instance (e.g. a different rho, alpha or tolerances)
+                cold_start_secondary : Secondary starts every solve from zero instead of the previous solution
+                chunk_iterations     : Cancellation granularity. Solves run in chunks of this many iterations and the
+                                       loser stops at its next chunk boundary. (Multiple of check_termination)
+                cpu                  : Core the secondary solver thread is pinned to, -1 leaves it unpinned
+        */
+        struct RacingSettings {
+            osqp::OsqpSettings secondary_settings;
+            bool cold_start_secondary = true;
+            int chunk_iterations = 25;
+            int cpu = -1;
+        };
+
+        inline bool is_acceptable(osqp::OsqpExitCode exit_code) {
+            return exit_code == osqp::OsqpExitCode::kOptimal;
+        }
+
+        /*
+            Cancellable Solve: Runs OSQP in chunks of chunk_iterations until it terminates, max_iter iterations are spent
+            or cancelled is set. (kInterrupted) Each chunk continues from the iterate of the previous one, so the solver
+            must be set up with warm_start enabled. The solver's iteration limit is restored to max_iter before returning.
+        */
+        inline osqp::OsqpExitCode solve_cancellable(
+            osqp::OsqpSolver& solver, int max_iter, int chunk_iterations, const std::atomic<bool>& cancelled
+        ) {
+            osqp::OsqpExitCode exit_code = osqp::OsqpExitCode::kUnknown;
+            int remaining = max_iter;
+            while(remaining > 0) {
+                const int chunk = std::min(chunk_iterations, remaining);
+                if(!solver.UpdateMaxIter(chunk).ok()) {
+                    exit_code = osqp::OsqpExitCode::kUnknown;
+                    break;
+                }
+                exit_code = solver.Solve();
+                remaining -= chunk;
+                if(exit_code != osqp::OsqpExitCode::kMaxIterations)
+                    break;
+                if(remaining > 0 && cancelled.load(std::memory_order_relaxed)) {
+                    exit_code = osqp::OsqpExitCode::kInterrupted;
+                    break;
+                }
+            }
+            if(!solver.UpdateMaxIter(max_iter).ok())
+                return osqp::OsqpExitCode::kUnknown;
+            return exit_code;
+        }
+
+        // Outcome of one run():
+        //   raced      : False if the secondary was still winding down from an earlier race and the primary solved alone
+        //   blocked_ns : Time run() spent after the winner was known, waiting for a cancelled primary to finish its chunk
+        struct RaceResult {
+            Racer winner = Racer::kNone;
+            osqp::OsqpExitCode exit_code = osqp::OsqpExitCode::kUnknown;
+            bool raced = false;
+            int64_t blocked_ns = 0;
+        };
+
+        /*
+            Solver Race: One QP solved by two solvers at once. The primary runs on the calling thread and the
+            secondary on a dedicated thread. The first acceptable result wins and cancels the other solve.
+            run() returns once the winner is known and the primary has stopped: A primary cancelled by the secondary
+            finishes its current chunk first. (RaceResult::blocked_ns) A secondary that lost winds down in the background
+            on its own copy of the inputs, and sits out the races that start before it is idle again.
+            stop() waits for it.
+        */
+        class SolverRace {
+            public:
+                using SecondaryJob = std::function<osqp::OsqpExitCode(const std::atomic<bool>& cancelled)>;
+
+                ~SolverRace() {
+                    stop();
+                }
+
+                absl::Status start(SecondaryJob new_secondary_job, int cpu = -1) {
+                    if(thread.joinable())
+                        return absl::FailedPreconditionError("Solver race already started.");
+
+                    secondary_job = std::move(new_secondary_job);
+                    running = true;
+                    thread = std::thread(&SolverRace::secondary_loop, this);
+                    if(cpu >= 0) {
+                        cpu_set_t cpu_set;
+                        CPU_ZERO(&cpu_set);
+                        CPU_SET(cpu, &cpu_set);
+                        if(pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpu_set) != 0) {
+                            stop();
+                            return absl::InvalidArgumentError("Failed to pin the secondary solver thread to cpu " + std::to_string(cpu) + ".");
+                        }
+                    }
+                    return absl::OkStatus();
+                }
+
+                void stop() {
+                    if(!thread.joinable())
+                        return;
+                    wait_for_secondary();
+                    running = false;
+                    start_race.release();
+                    thread.join();
+                }
+
+                bool is_running() const {
+                    return thread.joinable();
+                }
+
+                // Runs primary_job(cancelled) on the calling thread against the secondary job. stage_secondary() is called
+                // on the calling thread, only while the secondary is idle, to copy the inputs the secondary job reads.
+                // result.exit_code is the winner's, or the primary's if neither result was acceptable.
+                template <typename StageSecondary, typename PrimaryJob>
+                RaceResult run(StageSecondary&& stage_secondary, PrimaryJob&& primary_job) {
+                    RaceResult result;
+                    cancel_primary.store(false, std::memory_order_relaxed);
+
+                    // Busy secondary: (It lost an earlier race, whose winner keeps it from claiming this one)
+                    if(!secondary_idle()) {
+                        result.exit_code = primary_job(cancel_primary);
+                        result.winner = is_acceptable(result.exit_code) ? Racer::kPrimary : Racer::kNone;
+                        return result;
+                    }
+
+                    stage_secondary();
+                    result.raced = true;
+                    cancel_secondary.store(false, std::memory_order_relaxed);
+                    winner.store(Racer::kNone, std::memory_order_relaxed);
+                    secondary_busy = true;
+                    start_race.release();
+
+                    const osqp::OsqpExitCode primary_exit_code = primary_job(cancel_primary);
+                    if(is_acceptable(primary_exit_code) && claim(Racer::kPrimary)) {
+                        cancel_secondary.store(true, std::memory_order_relaxed);
+                        result.winner = Racer::kPrimary;
+                        result.exit_code = primary_exit_code;
+                        return result;
+                    }
+
+                    // Primary lost or failed: (The secondary has either finished or is the only one left)
+                    wait_for_secondary();
+                    if(winner.load(std::memory_order_acquire) == Racer::kSecondary) {
+                        result.winner = Racer::kSecondary;
+                        result.exit_code = secondary_exit_code;
+                        result.blocked_ns = std::max<int64_t>(now_ns() - secondary_won_ns, 0);
+                        return result;
+                    }
+                    result.exit_code = primary_exit_code;
+                    return result;
+                }
+
+            private:
+                static int64_t now_ns() {
+                    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+                }
+
+                bool claim(Racer racer) {
+                    Racer expected = Racer::kNone;
+                    return winner.compare_exchange_strong(expected, racer, std::memory_order_acq_rel);
+                }
+
+                bool secondary_idle() {
+                    if(secondary_busy && finished.try_acquire())
+                        secondary_busy = false;
+                    return !secondary_busy;
+                }
+
+                void wait_for_secondary() {
+                    if(!secondary_busy)
+                        return;
+                    finished.acquire();
+                    secondary_busy = false;
+                }
+
+                void secondary_loop() {
+                    while(true) {
+                        start_race.acquire();
+                        if(!running)
+                            break;
+
+                        const osqp::OsqpExitCode exit_code = secondary_job(cancel_secondary);
+                        secondary_exit_code = exit_code;
+                        if(is_acceptable(exit_code) && claim(Racer::kSecondary)) {
+                            secondary_won_ns = now_ns();
+                            cancel_primary.store(true, std::memory_order_relaxed);
+                        }
+                        finished.release();
+                    }
+                }
+
+                SecondaryJob secondary_job;
+                std::thread thread;
+                std::atomic<bool> running{false};
+                std::atomic<Racer> winner{Racer::kNone};
+                std::atomic<bool> cancel_primary{false};
+                std::atomic<bool> cancel_secondary{false};
+                std::binary_semaphore start_race{0};
+                std::binary_semaphore finished{0};
+                // Caller Only:
+                bool secondary_busy = false;
+                // Secondary Thread Only: (Read by the caller after finished)
+                osqp::OsqpExitCode secondary_exit_code = osqp::OsqpExitCode::kUnknown;
+                int64_t secondary_won_ns = 0;
+        };
+    }
+}
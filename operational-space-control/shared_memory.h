@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "absl/status/status.h"
+
+
+namespace operational_space_controller {
+    namespace shared_memory {
+        /*
+            Sequence Lock Slot: Single writer, any number of lock free readers.
+            The sequence is odd while a write is in progress and 2k once the k-th write completed.
+            Writers never wait on readers. Readers detect a torn copy and retry.
+        */
+        template <typename T>
+        struct alignas(64) SequenceLockSlot {
+            static_assert(std::is_trivially_copyable_v<T>);
+            static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+            std::atomic<uint64_t> sequence;
+            T value;
+
+            // Returns the sequence of the written value:
+            uint64_t write(const T& new_value) {
+                const uint64_t current = sequence.load(std::memory_order_relaxed);
+                sequence.store(current + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                std::memcpy(&value, &new_value, sizeof(T));
+                sequence.store(current + 2, std::memory_order_release);
+                return current + 2;
+            }
+
+            // Returns the sequence of the copied value, or 0 if nothing was written yet or the copy was torn:
+            uint64_t try_read(T& out) const {
+                const uint64_t before = sequence.load(std::memory_order_acquire);
+                if(before == 0 || (before & 1))
+                    return 0;
+                std::memcpy(&out, &value, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return sequence.load(std::memory_order_relaxed) == before ? before : 0;
+            }
+
+            uint64_t read(T& out, int max_attempts = 4) const {
+                for(int attempt = 0; attempt < max_attempts; attempt++) {
+                    const uint64_t result = try_read(out);
+                    if(result != 0)
+                        return result;
+                }
+                return 0;
+            }
+        };
+
+        /*
+            Shared Memory Region: RAII POSIX shared memory mapping.
+                create : Creates (or truncates) the object, maps it read/write and faults in all pages.
+                         The creator unlinks the object on close.
+                attach : Maps an existing object read only or read/write.
+        */
+        class SharedMemoryRegion {
+            public:
+                SharedMemoryRegion() = default;
+                SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+                SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+                ~SharedMemoryRegion() { std::ignore = close(); }
+
+                // name: POSIX shared memory object name (e.g. "/osc_telemetry")
+                absl::Status create(const std::string& name, size_t region_size) {
+                    if(is_open())
+                        return absl::FailedPreconditionError("Shared memory region already open.");
+
+                    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+                    if(fd == -1)
+                        return absl::InternalError("Failed to open shared memory: " + name);
+
+                    if(ftruncate(fd, region_size) == -1) {
+                        ::close(fd);
+                        shm_unlink(name.c_str());
+                        return absl::InternalError("Failed to size shared memory: " + name);
+                    }
+
+                    void* mapping = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                    ::close(fd);
+                    if(mapping == MAP_FAILED) {
+                        shm_unlink(name.c_str());
+                        return absl::InternalError("Failed to map shared memory: " + name);
+                    }
+
+                    // Fault in the pages now instead of on the control thread:
+                    std::memset(mapping, 0, region_size);
+
+                    memory = mapping;
+                    size = region_size;
+                    shm_name = name;
+                    owner = true;
+                    return absl::OkStatus();
+                }
+
+                absl::Status attach(const std::string& name, bool writable) {
+                    if(is_open())
+                        return absl::FailedPreconditionError("Shared memory region already open.");
+
+                    int fd = shm_open(name.c_str(), writable ? O_RDWR : O_RDONLY, 0);
+                    if(fd == -1)
+                        return absl::NotFoundError("Shared memory not found: " + name);
+
+                    struct stat file_stat;
+                    if(fstat(fd, &file_stat) == -1 || file_stat.st_size == 0) {
+                        ::close(fd);
+                        return absl::DataLossError("Shared memory is not initialized: " + name);
+                    }
+
+                    void* mapping = mmap(nullptr, file_stat.st_size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+                    ::close(fd);
+                    if(mapping == MAP_FAILED)
+                        return absl::InternalError("Failed to map shared memory: " + name);
+
+                    memory = mapping;
+                    size = file_stat.st_size;
+                    shm_name = name;
+                    owner = false;
+                    return absl::OkStatus();
+                }
+
+                absl::Status close() {
+                    if(!is_open())
+                        return absl::OkStatus();
+
+                    munmap(memory, size);
+                    if(owner)
+                        shm_unlink(shm_name.c_str());
+                    memory = nullptr;
+                    size = 0;
+                    return absl::OkStatus();
+                }
+
+                bool is_open() const {
+                    return memory != nullptr;
+                }
+
+                void* data() const {
+                    return memory;
+                }
+
+                size_t region_size() const {
+                    return size;
+                }
+
+            private:
+                std::string shm_name;
+                void* memory = nullptr;
+                size_t size = 0;
+                bool owner = false;
+        };
+    }
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include "absl/status/status.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/aliases.h"
+#include "operational-space-control/containers.h"
+#include "operational-space-control/shared_memory.h"
+
+using namespace operational_space_controller::aliases;
+
+
+namespace operational_space_controller {
+    namespace transport {
+        // Layout version: Bump on any change to the records or TransportHeader.
+        constexpr uint32_t kTransportMagic = 0x5053534f;  // "OSSP"
+        constexpr uint32_t kTransportVersion = 1;
+
+        // State sample written by the driver: (Mirrors containers::State, timestamp is steady_clock in nanoseconds)
+        template <typename Descriptor>
+        struct StateRecord {
+            using model = typename Descriptor::model;
+
+            int64_t timestamp_ns;
+            double motor_position[model::nu_size];
+            double motor_velocity[model::nu_size];
+            double motor_acceleration[model::nu_size];
+            double torque_estimate[model::nu_size];
+            double body_rotation[4];
+            double linear_body_velocity[3];
+            double angular_body_velocity[3];
+            double linear_body_acceleration[3];
+            double contact_mask[model::contact_site_ids_size];
+        };
+
+        // Torque command written by the controller: (Tagged with the state sample it was computed from)
+        template <typename Descriptor>
+        struct TorqueRecord {
+            using model = typename Descriptor::model;
+
+            uint64_t state_sequence;
+            int64_t state_timestamp_ns;
+            int64_t timestamp_ns;
+            double torque_command[model::nu_size];
+        };
+
+        struct alignas(64) TransportHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t state_record_size;
+            uint32_t torque_record_size;
+            uint32_t nu_size;
+            uint32_t contact_site_ids_size;
+        };
+
+        template <typename Descriptor>
+        struct TransportLayout {
+            TransportHeader header;
+            shared_memory::SequenceLockSlot<StateRecord<Descriptor>> state;
+            shared_memory::SequenceLockSlot<TorqueRecord<Descriptor>> torque;
+        };
+
+        inline int64_t now_ns() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count();
+        }
+
+        /*
+            Shared Memory Transport: Latest state and torque slots shared by a driver process and the controller.
+                Driver     : create(), publish_state(), read_torque()
+                Controller : attach(), read_state(), publish_torque()
+            Each slot has exactly one writer. Reads and writes are plain copies into the mapping
+            (no serialization, no syscalls). Sequences are 0 until the first write and increase with every write.
+        */
+        template <typename Descriptor>
+        class SharedMemoryTransport {
+            using model = typename Descriptor::model;
+            using Layout = TransportLayout<Descriptor>;
+
+            public:
+                using State = containers::State<Descriptor>;
+                using StateRecord = transport::StateRecord<Descriptor>;
+                using TorqueRecord = transport::TorqueRecord<Descriptor>;
+
+                // name: POSIX shared memory object name (e.g. "/osc_transport")
+                absl::Status create(const std::string& name) {
+                    absl::Status result = region.create(name, sizeof(Layout));
+                    if(!result.ok())
+                        return result;
+
+                    layout = static_cast<Layout*>(region.data());
+                    new (&layout->header) TransportHeader{
+                        .magic = kTransportMagic,
+                        .version = kTransportVersion,
+                        .state_record_size = sizeof(StateRecord),
+                        .torque_record_size = sizeof(TorqueRecord),
+                        .nu_size = model::nu_size,
+                        .contact_site_ids_size = model::contact_site_ids_size,
+                    };
+                    return absl::OkStatus();
+                }
+
+                absl::Status attach(const std::string& name) {
+                    absl::Status result = region.attach(name, /*writable=*/true);
+                    if(!result.ok())
+                        return result;
+
+                    // Validate Layout:
+                    const TransportHeader* header = static_cast<const TransportHeader*>(region.data());
+                    if(
+                        region.region_size() < sizeof(Layout) ||
+                        header->magic != kTransportMagic ||
+                        header->version != kTransportVersion ||
+                        header->state_record_size != sizeof(StateRecord) ||
+                        header->torque_record_size != sizeof(TorqueRecord) ||
+                        header->nu_size != model::nu_size ||
+                        header->contact_site_ids_size != model::contact_site_ids_size
+                    ) {
+                        std::ignore = region.close();
+                        return absl::FailedPreconditionError("Shared memory transport layout mismatch: " + name);
+                    }
+
+                    layout = static_cast<Layout*>(region.data());
+                    return absl::OkStatus();
+                }
+
+                absl::Status close() {
+                    layout = nullptr;
+                    return region.close();
+                }
+
+                bool is_open() const {
+                    return region.is_open();
+                }
+
+                /* Driver Side: */
+                // Stamped with the capture time of the state, or the publish time if the state is unstamped:
+                uint64_t publish_state(const State& state) {
+                    return publish_state(state, state.timestamp_ns != 0 ? state.timestamp_ns : now_ns());
+                }
+
+                uint64_t publish_state(const State& state, int64_t timestamp_ns) {
+                    StateRecord& record = state_record;
+                    record.timestamp_ns = timestamp_ns;
+                    Eigen::Map<Vector<model::nu_size>>(record.motor_position) = state.motor_position;
+                    Eigen::Map<Vector<model::nu_size>>(record.motor_velocity) = state.motor_velocity;
+                    Eigen::Map<Vector<model::nu_size>>(record.motor_acceleration) = state.motor_acceleration;
+                    Eigen::Map<Vector<model::nu_size>>(record.torque_estimate) = state.torque_estimate;
+                    Eigen::Map<Vector<4>>(record.body_rotation) = state.body_rotation;
+                    Eigen::Map<Vector<3>>(record.linear_body_velocity) = state.linear_body_velocity;
+                    Eigen::Map<Vector<3>>(record.angular_body_velocity) = state.angular_body_velocity;
+                    Eigen::Map<Vector<3>>(record.linear_body_acceleration) = state.linear_body_acceleration;
+                    Eigen::Map<Vector<model::contact_site_ids_size>>(record.contact_mask) = state.contact_mask;
+                    return layout->state.write(record);
+                }
+
+                // Returns the sequence of the state sample the torque was computed from, or 0 if none is available:
+                uint64_t read_torque(TorqueRecord& record) const {
+                    if(layout->torque.read(record) == 0)
+                        return 0;
+                    return record.state_sequence;
+                }
+
+                /* Controller Side: */
+                // Returns the sequence of the copied state sample, or 0 if none is available:
+                uint64_t read_state(State& state, int64_t& timestamp_ns) {
+                    const uint64_t sequence = layout->state.read(state_record);
+                    if(sequence == 0)
+                        return 0;
+
+                    const StateRecord& record = state_record;
+                    timestamp_ns = record.timestamp_ns;
+                    // Sample number: (The slot's sequence advances by 2 per write)
+                    state.timestamp_ns = record.timestamp_ns;
+                    state.sequence = sequence / 2;
+                    state.motor_position = Eigen::Map<const Vector<model::nu_size>>(record.motor_position);
+                    state.motor_velocity = Eigen::Map<const Vector<model::nu_size>>(record.motor_velocity);
+                    state.motor_acceleration = Eigen::Map<const Vector<model::nu_size>>(record.motor_acceleration);
+                    state.torque_estimate = Eigen::Map<const Vector<model::nu_size>>(record.torque_estimate);
+                    state.body_rotation = Eigen::Map<const Vector<4>>(record.body_rotation);
+                    state.linear_body_velocity = Eigen::Map<const Vector<3>>(record.linear_body_velocity);
+                    state.angular_body_velocity = Eigen::Map<const Vector<3>>(record.angular_body_velocity);
+                    state.linear_body_acceleration = Eigen::Map<const Vector<3>>(record.linear_body_acceleration);
+                    state.contact_mask = Eigen::Map<const Vector<model::contact_site_ids_size>>(record.contact_mask);
+                    return sequence;
+                }
+
+                void publish_torque(const Vector<model::nu_size>& torque_command, uint64_t state_sequence, int64_t state_timestamp_ns) {
+                    TorqueRecord& record = torque_record;
+                    record.state_sequence = state_sequence;
+                    record.state_timestamp_ns = state_timestamp_ns;
+                    record.timestamp_ns = now_ns();
+                    Eigen::Map<Vector<model::nu_size>>(record.torque_command) = torque_command;
+                    layout->torque.write(record);
+                }
+
+            private:
+                shared_memory::SharedMemoryRegion region;
+                Layout* layout = nullptr;
+                // Staging records: (Keeps the copies out of the shared mapping until they are complete)
+                StateRecord state_record;
+                TorqueRecord torque_record;
+        };
+    }
+}
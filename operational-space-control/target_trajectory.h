@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+
+#include "absl/status/status.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/aliases.h"
+
+using namespace operational_space_controller::aliases;
+
+
+namespace operational_space_controller {
+    namespace target_trajectory {
+        /*
+            Trajectory Segment: Cubic polynomial in TaskspaceTargets over [start_ns, start_ns + duration_ns].
+                targets(t) = c0 + c1 s + c2 s^2 + c3 s^3,  s = (t - start_ns) / duration_ns clamped to [0, 1]
+            A segment holds its end value after it finishes. Times are steady_clock in nanoseconds (see transport::now_ns).
+        */
+        template <typename Descriptor>
+        struct TrajectorySegment {
+            using TaskspaceTargets = Matrix<Descriptor::model::site_ids_size, 6>;
+
+            int64_t start_ns = 0;
+            int64_t duration_ns = 0;
+            std::array<TaskspaceTargets, 4> coefficients = {
+                TaskspaceTargets::Zero(), TaskspaceTargets::Zero(), TaskspaceTargets::Zero(), TaskspaceTargets::Zero()
+            };
+            // Set by TargetTrajectory: (Segments of older plans are dropped)
+            uint64_t plan = 0;
+
+            static TrajectorySegment constant(int64_t start_ns, const TaskspaceTargets& targets) {
+                TrajectorySegment segment;
+                segment.start_ns = start_ns;
+                segment.coefficients[0] = targets;
+                return segment;
+            }
+
+            static TrajectorySegment linear(int64_t start_ns, int64_t duration_ns, const TaskspaceTargets& from, const TaskspaceTargets& to) {
+                TrajectorySegment segment;
+                segment.start_ns = start_ns;
+                segment.duration_ns = duration_ns;
+                segment.coefficients[0] = from;
+                segment.coefficients[1] = to - from;
+                return segment;
+            }
+
+            // Cubic Hermite: Endpoint values and rates of change per second. (Consecutive segments form a C1 spline)
+            static TrajectorySegment cubic_hermite(
+                int64_t start_ns, int64_t duration_ns,
+                const TaskspaceTargets& from, const TaskspaceTargets& from_rate,
+                const TaskspaceTargets& to, const TaskspaceTargets& to_rate
+            ) {
+                const double duration = 1e-9 * duration_ns;
+                TrajectorySegment segment;
+                segment.start_ns = start_ns;
+                segment.duration_ns = duration_ns;
+                segment.coefficients[0] = from;
+                segment.coefficients[1] = duration * from_rate;
+                segment.coefficients[2] = 3.0 * (to - from) - duration * (2.0 * from_rate + to_rate);
+                segment.coefficients[3] = 2.0 * (from - to) + duration * (from_rate + to_rate);
+                return segment;
+            }
+
+            int64_t end_ns() const {
+                return start_ns + duration_ns;
+            }
+
+            void evaluate(int64_t time_ns, TaskspaceTargets& targets) const {
+                double s = 1.0;
+                if(duration_ns > 0 && time_ns < end_ns())
+                    s = time_ns <= start_ns ? 0.0 : static_cast<double>(time_ns - start_ns) / duration_ns;
+                // Horner's method:
+                targets = coefficients[3];
+                for(int i = 2; i >= 0; i--)
+                    targets = s * targets + coefficients[i];
+            }
+        };
+
+        // Waypoint: Targets reached at time_ns. (Linearly interpolated between consecutive waypoints)
+        template <typename Descriptor>
+        struct TargetWaypoint {
+            int64_t time_ns;
+            Matrix<Descriptor::model::site_ids_size, 6> targets;
+        };
+
+        /*
+            Target Trajectory: Preallocated single producer, single consumer queue of trajectory segments.
+                Producer (planner thread)  : replace(), replace_waypoints(), append()
+                Consumer (control thread)  : evaluate() once per tick at the tick time, clear()
+            No locks and no allocations on either side. replace() starts a new plan: queued segments of older
+            plans are dropped by the consumer, and the active segment is kept until the first segment of the new plan starts.
+            The producer fails with ResourceExhaustedError instead of overwriting segments the consumer has not read.
+        */
+        template <typename Descriptor, uint64_t Capacity = 64>
+        class TargetTrajectory {
+            static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+            public:
+                using Segment = TrajectorySegment<Descriptor>;
+                using Waypoint = TargetWaypoint<Descriptor>;
+                using TaskspaceTargets = typename Segment::TaskspaceTargets;
+
+                /* Producer: */
+                absl::Status replace(std::span<const Segment> segments) {
+                    absl::Status result = validate(segments, /*new_plan=*/true);
+                    if(!result.ok())
+                        return result;
+
+                    const uint64_t new_plan = producer_plan + 1;
+                    for(const Segment& segment : segments)
+                        push(segment, new_plan);
+                    commit_plan(new_plan, segments.empty() ? INT64_MIN : segments.back().start_ns);
+                    return absl::OkStatus();
+                }
+
+                absl::Status replace_waypoints(std::span<const Waypoint> waypoints) {
+                    if(waypoints.empty())
+                        return absl::InvalidArgumentError("Trajectory needs at least one waypoint.");
+                    if(std::max<size_t>(waypoints.size() - 1, 1) > free_slots())
+                        return absl::ResourceExhaustedError("Target trajectory queue is full.");
+                    for(size_t i = 1; i < waypoints.size(); i++) {
+                        if(waypoints[i].time_ns < waypoints[i - 1].time_ns)
+                            return absl::InvalidArgumentError("Waypoint times must be non-decreasing.");
+                    }
+
+                    // Interpolate from the first waypoint once it is reached and hold the last one:
+                    const uint64_t new_plan = producer_plan + 1;
+                    if(waypoints.size() == 1)
+                        push(Segment::constant(waypoints.front().time_ns, waypoints.front().targets), new_plan);
+                    for(size_t i = 1; i < waypoints.size(); i++) {
+                        const Waypoint& from = waypoints[i - 1];
+                        const Waypoint& to = waypoints[i];
+                        push(Segment::linear(from.time_ns, to.time_ns - from.time_ns, from.targets, to.targets), new_plan);
+                    }
+                    commit_plan(new_plan, waypoints.size() > 1 ? waypoints[waypoints.size() - 2].time_ns : waypoints.front().time_ns);
+                    return absl::OkStatus();
+                }
+
+                // Extends the current plan: (Segments must start at or after the last queued segment)
+                absl::Status append(std::span<const Segment> segments) {
+                    absl::Status result = validate(segments, /*new_plan=*/false);
+                    if(!result.ok())
+                        return result;
+
+                    for(const Segment& segment : segments)
+                        push(segment, producer_plan);
+                    if(!segments.empty())
+                        last_start_ns = segments.back().start_ns;
+                    head.store(producer_head, std::memory_order_release);
+                    return absl::OkStatus();
+                }
+
+                /* Consumer: */
+                // Writes the targets at time_ns. Returns false if no segment has started yet.
+                bool evaluate(int64_t time_ns, TaskspaceTargets& targets) {
+                    // Head before plan: A visible segment implies its plan is visible
+                    const uint64_t published_head = head.load(std::memory_order_acquire);
+                    const uint64_t published_plan = plan.load(std::memory_order_acquire);
+                    uint64_t position = tail.load(std::memory_order_relaxed);
+                    while(position != published_head) {
+                        const Segment& segment = segments[position % Capacity];
+                        // Stale plan: Drop without activating
+                        if(segment.plan < published_plan) {
+                            position++;
+                            continue;
+                        }
+                        // Newer segments take over once they start:
+                        if(segment.start_ns > time_ns)
+                            break;
+                        active = segment;
+                        has_active = true;
+                        position++;
+                    }
+                    tail.store(position, std::memory_order_release);
+
+                    if(!has_active)
+                        return false;
+                    active.evaluate(time_ns, targets);
+                    return true;
+                }
+
+                // Drops queued segments and the active segment:
+                void clear() {
+                    tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+                    has_active = false;
+                }
+
+                bool is_active() const {
+                    return has_active;
+                }
+
+            private:
+                size_t free_slots() const {
+                    return Capacity - (producer_head - tail.load(std::memory_order_acquire));
+                }
+
+                absl::Status validate(std::span<const Segment> new_segments, bool new_plan) const {
+                    if(new_segments.size() > free_slots())
+                        return absl::ResourceExhaustedError("Target trajectory queue is full.");
+                    int64_t previous_start_ns = new_plan ? INT64_MIN : last_start_ns;
+                    for(const Segment& segment : new_segments) {
+                        if(segment.duration_ns < 0)
+                            return absl::InvalidArgumentError("Trajectory segment duration must be non-negative.");
+                        if(segment.start_ns < previous_start_ns)
+                            return absl::InvalidArgumentError("Trajectory segments must be ordered by start time.");
+                        previous_start_ns = segment.start_ns;
+                    }
+                    return absl::OkStatus();
+                }
+
+                void push(const Segment& segment, uint64_t segment_plan) {
+                    Segment& slot = segments[producer_head % Capacity];
+                    slot = segment;
+                    slot.plan = segment_plan;
+                    producer_head++;
+                }
+
+                // Publishes the plan before its segments so the consumer never activates a stale segment queued ahead of them:
+                void commit_plan(uint64_t new_plan, int64_t new_last_start_ns) {
+                    producer_plan = new_plan;
+                    last_start_ns = new_last_start_ns;
+                    plan.store(new_plan, std::memory_order_release);
+                    head.store(producer_head, std::memory_order_release);
+                }
+
+                std::array<Segment, Capacity> segments;
+                // Shared Indices: (Written by one side each)
+                alignas(64) std::atomic<uint64_t> head{0};
+                alignas(64) std::atomic<uint64_t> tail{0};
+                alignas(64) std::atomic<uint64_t> plan{0};
+                // Producer Only:
+                alignas(64) uint64_t producer_head = 0;
+                uint64_t producer_plan = 0;
+                int64_t last_start_ns = INT64_MIN;
+                // Consumer Only:
+                alignas(64) Segment active;
+                bool has_active = false;
+        };
+    }
+}
@@ -0,0 +1,221 @@
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/target_trajectory.h"
+
+using namespace operational_space_controller;
+
+
+/*
+    Target Trajectory Tests: Continuity of the cubic Hermite segments, plan replacement, full and empty
+    queue behavior and a planner / control thread stress run over the lock free segment queue.
+*/
+namespace {
+    // Minimal descriptor: (TargetTrajectory only reads the number of sites)
+    struct TestDescriptor {
+        struct model {
+            static constexpr int site_ids_size = 2;
+        };
+    };
+
+    using Trajectory = target_trajectory::TargetTrajectory<TestDescriptor, 4>;
+    using Segment = Trajectory::Segment;
+    using Waypoint = Trajectory::Waypoint;
+    using TaskspaceTargets = Trajectory::TaskspaceTargets;
+
+    constexpr int64_t kSecond = 1'000'000'000;
+
+    TaskspaceTargets constant_targets(double value) {
+        return TaskspaceTargets::Constant(value);
+    }
+
+    // Rate of change per second from the segment coefficients:
+    TaskspaceTargets rate(const Segment& segment, double s) {
+        const TaskspaceTargets derivative = segment.coefficients[1] + 2.0 * s * segment.coefficients[2] + 3.0 * s * s * segment.coefficients[3];
+        return derivative / (1e-9 * segment.duration_ns);
+    }
+
+    TEST(TrajectorySegmentTest, CubicHermiteSplineIsContinuous) {
+        std::srand(0);
+        const std::array<TaskspaceTargets, 3> knots = {TaskspaceTargets::Random(), TaskspaceTargets::Random(), TaskspaceTargets::Random()};
+        const std::array<TaskspaceTargets, 3> rates = {TaskspaceTargets::Random(), TaskspaceTargets::Random(), TaskspaceTargets::Random()};
+        const Segment first = Segment::cubic_hermite(0, kSecond / 2, knots[0], rates[0], knots[1], rates[1]);
+        const Segment second = Segment::cubic_hermite(first.end_ns(), 2 * kSecond, knots[1], rates[1], knots[2], rates[2]);
+
+        // Endpoint values:
+        TaskspaceTargets targets;
+        first.evaluate(first.start_ns, targets);
+        EXPECT_TRUE(targets.isApprox(knots[0], 1e-12));
+        first.evaluate(first.end_ns(), targets);
+        EXPECT_TRUE(targets.isApprox(knots[1], 1e-12));
+        second.evaluate(second.start_ns, targets);
+        EXPECT_TRUE(targets.isApprox(knots[1], 1e-12));
+        second.evaluate(second.end_ns(), targets);
+        EXPECT_TRUE(targets.isApprox(knots[2], 1e-12));
+
+        // Endpoint rates: (C1 across the knot)
+        EXPECT_TRUE(rate(first, 0.0).isApprox(rates[0], 1e-9));
+        EXPECT_TRUE(rate(first, 1.0).isApprox(rates[1], 1e-9));
+        EXPECT_TRUE(rate(second, 0.0).isApprox(rates[1], 1e-9));
+        EXPECT_TRUE(rate(second, 1.0).isApprox(rates[2], 1e-9));
+
+        // Central difference across the knot matches the knot rate:
+        const int64_t h = 1000;
+        TaskspaceTargets before, after;
+        first.evaluate(first.end_ns() - h, before);
+        second.evaluate(second.start_ns + h, after);
+        EXPECT_LT(((after - before) / (2e-9 * h) - rates[1]).cwiseAbs().maxCoeff(), 1e-3);
+    }
+
+    TEST(TrajectorySegmentTest, HoldsEndValueAfterFinishing) {
+        const Segment segment = Segment::linear(kSecond, kSecond, constant_targets(1.0), constant_targets(3.0));
+        TaskspaceTargets targets;
+        segment.evaluate(kSecond + kSecond / 2, targets);
+        EXPECT_TRUE(targets.isApprox(constant_targets(2.0)));
+        segment.evaluate(10 * kSecond, targets);
+        EXPECT_TRUE(targets.isApprox(constant_targets(3.0)));
+    }
+
+    TEST(TargetTrajectoryTest, EmptyQueueHasNoTargets) {
+        Trajectory trajectory;
+        TaskspaceTargets targets;
+        EXPECT_FALSE(trajectory.evaluate(0, targets));
+        EXPECT_FALSE(trajectory.is_active());
+
+        const std::array<Segment, 1> segments = {Segment::constant(100, constant_targets(1.0))};
+        ASSERT_TRUE(trajectory.replace(segments).ok());
+        // Not started yet:
+        EXPECT_FALSE(trajectory.evaluate(50, targets));
+        EXPECT_TRUE(trajectory.evaluate(100, targets));
+        trajectory.clear();
+        EXPECT_FALSE(trajectory.is_active());
+        EXPECT_FALSE(trajectory.evaluate(200, targets));
+    }
+
+    TEST(TargetTrajectoryTest, FullQueueIsRejected) {
+        Trajectory trajectory;
+        std::vector<Segment> segments;
+        for(int i = 0; i < 4; i++)
+            segments.push_back(Segment::constant(i, constant_targets(i)));
+        ASSERT_TRUE(trajectory.replace(segments).ok());
+
+        const std::array<Segment, 1> extra = {Segment::constant(10, constant_targets(10.0))};
+        EXPECT_TRUE(absl::IsResourceExhausted(trajectory.append(extra)));
+        EXPECT_TRUE(absl::IsResourceExhausted(trajectory.replace(extra)));
+        const std::array<Waypoint, 2> waypoints = {Waypoint{0, constant_targets(0.0)}, Waypoint{10, constant_targets(1.0)}};
+        EXPECT_TRUE(absl::IsResourceExhausted(trajectory.replace_waypoints(waypoints)));
+
+        // Consuming frees the slots:
+        TaskspaceTargets targets;
+        ASSERT_TRUE(trajectory.evaluate(3, targets));
+        EXPECT_TRUE(targets.isApprox(constant_targets(3.0)));
+        EXPECT_TRUE(trajectory.append(extra).ok());
+        ASSERT_TRUE(trajectory.evaluate(10, targets));
+        EXPECT_TRUE(targets.isApprox(constant_targets(10.0)));
+    }
+
+    TEST(TargetTrajectoryTest, RejectsUnorderedSegments) {
+        Trajectory trajectory;
+        const std::array<Segment, 2> unordered = {Segment::constant(10, constant_targets(0.0)), Segment::constant(5, constant_targets(1.0))};
+        EXPECT_TRUE(absl::IsInvalidArgument(trajectory.replace(unordered)));
+        const std::array<Segment, 1> first = {Segment::constant(10, constant_targets(0.0))};
+        ASSERT_TRUE(trajectory.replace(first).ok());
+        const std::array<Segment, 1> earlier = {Segment::constant(5, constant_targets(1.0))};
+        EXPECT_TRUE(absl::IsInvalidArgument(trajectory.append(earlier)));
+    }
+
+    TEST(TargetTrajectoryTest, ReplaceDropsOlderPlan) {
+        Trajectory trajectory;
+        const std::array<Segment, 2> first_plan = {Segment::constant(0, constant_targets(1.0)), Segment::constant(100, constant_targets(2.0))};
+        ASSERT_TRUE(trajectory.replace(first_plan).ok());
+        TaskspaceTargets targets;
+        ASSERT_TRUE(trajectory.evaluate(0, targets));
+        EXPECT_TRUE(targets.isApprox(constant_targets(1.0)));
+
+        // The active segment is kept until the new plan starts, the queued segment of the old plan is dropped:
+        const std::array<Segment, 1> second_plan = {Segment::constant(50, constant_targets(3.0))};
+        ASSERT_TRUE(trajectory.replace(second_plan).ok());
+        ASSERT_TRUE(trajectory.evaluate(40, targets));
+        EXPECT_TRUE(targets.isApprox(constant_targets(1.0)));
+        ASSERT_TRUE(trajectory.evaluate(60, targets));
+        EXPECT_TRUE(targets.isApprox(constant_targets(3.0)));
+        ASSERT_TRUE(trajectory.evaluate(150, targets));
+        EXPECT_TRUE(targets.isApprox(constant_targets(3.0)));
+    }
+
+    TEST(TargetTrajectoryTest, ReplaceBeforeConsumingSkipsOlderPlan) {
+        Trajectory trajectory;
+        const std::array<Segment, 1> first_plan = {Segment::constant(0, constant_targets(1.0))};
+        const std::array<Segment, 1> second_plan = {Segment::constant(0, constant_targets(2.0))};
+        ASSERT_TRUE(trajectory.replace(first_plan).ok());
+        ASSERT_TRUE(trajectory.replace(second_plan).ok());
+        TaskspaceTargets targets;
+        ASSERT_TRUE(trajectory.evaluate(0, targets));
+        EXPECT_TRUE(targets.isApprox(constant_targets(2.0)));
+    }
+
+    TEST(TargetTrajectoryTest, WaypointsInterpolateLinearly) {
+        Trajectory trajectory;
+        const std::array<Waypoint, 3> waypoints = {
+            Waypoint{0, constant_targets(0.0)}, Waypoint{kSecond, constant_targets(2.0)}, Waypoint{3 * kSecond, constant_targets(0.0)}
+        };
+        ASSERT_TRUE(trajectory.replace_waypoints(waypoints).ok());
+        TaskspaceTargets targets;
+        ASSERT_TRUE(trajectory.evaluate(kSecond / 2, targets));
+        EXPECT_TRUE(targets.isApprox(constant_targets(1.0)));
+        ASSERT_TRUE(trajectory.evaluate(2 * kSecond, targets));
+        EXPECT_TRUE(targets.isApprox(constant_targets(1.0)));
+        ASSERT_TRUE(trajectory.evaluate(4 * kSecond, targets));
+        EXPECT_TRUE(targets.isZero());
+    }
+
+    // Planner thread replaces plans while the control thread evaluates every tick:
+    TEST(TargetTrajectoryTest, ConcurrentPlannerAndController) {
+        constexpr uint64_t kPlans = 20000;
+        target_trajectory::TargetTrajectory<TestDescriptor, 8> trajectory;
+        std::atomic<bool> done{false};
+
+        // Plan k holds 10 k, then 10 k + 1: (Every entry of a segment carries the same value)
+        std::thread planner([&]() {
+            for(uint64_t k = 1; k <= kPlans; k++) {
+                const std::array<Segment, 2> plan = {
+                    Segment::constant(0, constant_targets(10.0 * k)), Segment::constant(0, constant_targets(10.0 * k + 1.0))
+                };
+                while(!trajectory.replace(plan).ok())
+                    std::this_thread::yield();
+            }
+            done.store(true, std::memory_order_release);
+        });
+
+        uint64_t ticks = 0, torn = 0;
+        double last_value = 0.0;
+        bool monotonic = true;
+        TaskspaceTargets targets;
+        auto consume = [&]() {
+            if(!trajectory.evaluate(static_cast<int64_t>(ticks++), targets))
+                return;
+            const double value = targets(0, 0);
+            if((targets.array() != value).any())
+                torn++;
+            monotonic &= value >= last_value;
+            last_value = value;
+        };
+        while(!done.load(std::memory_order_acquire)) {
+            consume();
+            std::this_thread::yield();
+        }
+        planner.join();
+        consume();
+
+        EXPECT_EQ(torn, 0u);
+        EXPECT_TRUE(monotonic);
+        EXPECT_EQ(last_value, 10.0 * kPlans + 1.0);
+    }
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include "absl/status/status.h"
+
+#include "operational-space-control/shared_memory.h"
+
+
+namespace operational_space_controller {
+    namespace telemetry {
+        // Layout version: Bump on any change to TelemetryHeader or TelemetryRecord.
+        constexpr uint32_t kTelemetryMagic = 0x5443534f;  // "OSCT"
+        constexpr uint32_t kTelemetryVersion = 2;
+
+        /*
+            Telemetry Record: Fixed layout snapshot of one control tick.
+            Plain arrays only so external readers can map the record without Eigen.
+            Taskspace targets are stored row major (site_ids_size x 6).
+        */
+        template <typename Descriptor>
+        struct TelemetryRecord {
+            using model = typename Descriptor::model;
+            using optimization = typename Descriptor::optimization;
+
+            uint64_t tick;
+            int64_t timestamp_ns;
+            int32_t exit_code;
+            uint32_t reserved;
+            // Input Sample: (Sequence number and capture time of the state used by the tick)
+            uint64_t state_sequence;
+            int64_t state_timestamp_ns;
+            // Stage Timings: (microseconds)
+            double model_stage_us;
+            double solver_stage_us;
+            double latency_us;
+            // State Snapshot:
+            double motor_position[model::nu_size];
+            double motor_velocity[model::nu_size];
+            double motor_acceleration[model::nu_size];
+            double torque_estimate[model::nu_size];
+            double body_rotation[4];
+            double linear_body_velocity[3];
+            double angular_body_velocity[3];
+            double linear_body_acceleration[3];
+            double contact_mask[model::contact_site_ids_size];
+            // Inputs and Outputs:
+            double taskspace_targets[model::site_ids_size * 6];
+            double torque_command[model::nu_size];
+            double contact_forces[optimization::z_size];
+        };
+
+        struct alignas(64) TelemetryHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t record_size;
+            uint32_t capacity;
+            uint32_t nu_size;
+            uint32_t site_ids_size;
+            uint32_t contact_site_ids_size;
+            uint32_t reserved;
+            // Number of records published:
+            std::atomic<uint64_t> head;
+        };
+
+        // Shared memory layout: TelemetryHeader followed by capacity ring slots. (Record n lives in slot n % capacity)
+        template <typename Descriptor>
+        struct TelemetryLayout {
+            using Record = TelemetryRecord<Descriptor>;
+            using Slot = shared_memory::SequenceLockSlot<Record>;
+
+            static_assert(std::is_standard_layout_v<Record>);
+
+            static size_t size(uint32_t capacity) {
+                return sizeof(TelemetryHeader) + capacity * sizeof(Slot);
+            }
+
+            static Slot* slots(void* memory) {
+                return reinterpret_cast<Slot*>(static_cast<char*>(memory) + sizeof(TelemetryHeader));
+            }
+        };
+
+        /*
+            Telemetry Publisher: Single writer into a POSIX shared memory ring.
+            publish() never blocks and makes no syscalls. Readers that fall behind lose the
+            overwritten records instead of stalling the control thread.
+        */
+        template <typename Descriptor>
+        class TelemetryPublisher {
+            using Layout = TelemetryLayout<Descriptor>;
+            using Slot = typename Layout::Slot;
+
+            public:
+                using Record = TelemetryRecord<Descriptor>;
+
+                // name: POSIX shared memory object name (e.g. "/osc_telemetry")
+                absl::Status open(const std::string& name, uint32_t capacity = 1024) {
+                    if(capacity == 0)
+                        return absl::InvalidArgumentError("Telemetry capacity must be positive.");
+
+                    absl::Status result = region.create(name, Layout::size(capacity));
+                    if(!result.ok())
+                        return result;
+
+                    slots = Layout::slots(region.data());
+                    header = new (region.data()) TelemetryHeader{
+                        .magic = kTelemetryMagic,
+                        .version = kTelemetryVersion,
+                        .record_size = sizeof(Record),
+                        .capacity = capacity,
+                        .nu_size = Descriptor::model::nu_size,
+                        .site_ids_size = Descriptor::model::site_ids_size,
+                        .contact_site_ids_size = Descriptor::model::contact_site_ids_size,
+                        .reserved = 0,
+                        .head = 0,
+                    };
+                    return absl::OkStatus();
+                }
+
+                absl::Status close() {
+                    header = nullptr;
+                    slots = nullptr;
+                    return region.close();
+                }
+
+                bool is_open() const {
+                    return region.is_open();
+                }
+
+                void publish(const Record& record) {
+                    const uint64_t n = header->head.load(std::memory_order_relaxed);
+                    slots[n % header->capacity].write(record);
+                    header->head.store(n + 1, std::memory_order_release);
+                }
+
+            private:
+                shared_memory::SharedMemoryRegion region;
+                TelemetryHeader* header = nullptr;
+                Slot* slots = nullptr;
+        };
+
+        /*
+            Telemetry Reader: Attaches read only to a publisher's ring. Any number of readers may attach.
+            Reads are lock free and retry only when the publisher overwrote the slot mid copy.
+        */
+        template <typename Descriptor>
+        class TelemetryReader {
+            using Layout = TelemetryLayout<Descriptor>;
+            using Slot = typename Layout::Slot;
+
+            public:
+                using Record = TelemetryRecord<Descriptor>;
+
+                absl::Status open(const std::string& name) {
+                    absl::Status result = region.attach(name, /*writable=*/false);
+                    if(!result.ok())
+                        return result;
+
+                    // Validate Layout:
+                    const TelemetryHeader* mapped_header = static_cast<const TelemetryHeader*>(region.data());
+                    if(
+                        region.region_size() < sizeof(TelemetryHeader) ||
+                        mapped_header->magic != kTelemetryMagic ||
+                        mapped_header->version != kTelemetryVersion ||
+                        mapped_header->record_size != sizeof(Record) ||
+                        mapped_header->nu_size != Descriptor::model::nu_size ||
+                        mapped_header->site_ids_size != Descriptor::model::site_ids_size ||
+                        mapped_header->contact_site_ids_size != Descriptor::model::contact_site_ids_size ||
+                        region.region_size() < Layout::size(mapped_header->capacity)
+                    ) {
+                        std::ignore = region.close();
+                        return absl::FailedPreconditionError("Telemetry layout mismatch: " + name);
+                    }
+
+                    header = mapped_header;
+                    slots = Layout::slots(region.data());
+                    return absl::OkStatus();
+                }
+
+                absl::Status close() {
+                    header = nullptr;
+                    slots = nullptr;
+                    return region.close();
+                }
+
+                bool is_open() const {
+                    return region.is_open();
+                }
+
+                // Number of records published so far: (Records [head - capacity, head) are retained)
+                uint64_t head() const {
+                    return header->head.load(std::memory_order_acquire);
+                }
+
+                uint32_t capacity() const {
+                    return header->capacity;
+                }
+
+                // Copies record n. Returns false if it was not published yet, was overwritten or was torn.
+                bool read(uint64_t n, Record& record) const {
+                    const uint64_t expected_sequence = 2 * (n / header->capacity + 1);
+                    return slots[n % header->capacity].try_read(record) == expected_sequence;
+                }
+
+                // Copies the most recent complete record.
+                bool read_latest(Record& record, int max_attempts = 4) const {
+                    for(int attempt = 0; attempt < max_attempts; attempt++) {
+                        const uint64_t n = head();
+                        if(n == 0)
+                            return false;
+                        if(read(n - 1, record))
+                            return true;
+                    }
+                    return false;
+                }
+
+            private:
+                shared_memory::SharedMemoryRegion region;
+                const TelemetryHeader* header = nullptr;
+                const Slot* slots = nullptr;
+        };
+    }
+}
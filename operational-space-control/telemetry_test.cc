@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+
+#include "operational-space-control/shared_memory.h"
+#include "operational-space-control/telemetry.h"
+
+using namespace operational_space_controller;
+
+
+/*
+    Sequence Lock and Telemetry Ring Tests: A concurrent writer and reader never observe a torn record,
+    and a reader that falls behind the ring only loses the overwritten records.
+*/
+namespace {
+    // Minimal descriptor: (TelemetryRecord only reads these sizes)
+    struct TestDescriptor {
+        struct model {
+            static constexpr int nu_size = 12;
+            static constexpr int site_ids_size = 5;
+            static constexpr int contact_site_ids_size = 4;
+        };
+        struct optimization {
+            static constexpr int z_size = 12;
+        };
+    };
+
+    using Record = telemetry::TelemetryRecord<TestDescriptor>;
+
+    // Payload with a redundant checksum: (A torn copy mixes two writes and fails the check)
+    struct Payload {
+        uint64_t value;
+        uint64_t words[32];
+        uint64_t checksum;
+
+        static Payload make(uint64_t value) {
+            Payload payload;
+            payload.value = value;
+            for(int i = 0; i < 32; i++)
+                payload.words[i] = value * 2654435761u + i;
+            payload.checksum = ~value;
+            return payload;
+        }
+
+        bool is_consistent() const {
+            if(checksum != ~value)
+                return false;
+            for(int i = 0; i < 32; i++)
+                if(words[i] != value * 2654435761u + i)
+                    return false;
+            return true;
+        }
+    };
+
+    Record make_record(uint64_t n) {
+        Record record{};
+        record.tick = n;
+        record.timestamp_ns = static_cast<int64_t>(n);
+        std::fill(std::begin(record.motor_position), std::end(record.motor_position), static_cast<double>(n));
+        std::fill(std::begin(record.torque_command), std::end(record.torque_command), -static_cast<double>(n));
+        return record;
+    }
+
+    bool is_consistent(const Record& record) {
+        const double n = static_cast<double>(record.tick);
+        return record.timestamp_ns == static_cast<int64_t>(record.tick)
+            && std::all_of(std::begin(record.motor_position), std::end(record.motor_position), [n](double x) { return x == n; })
+            && std::all_of(std::begin(record.torque_command), std::end(record.torque_command), [n](double x) { return x == -n; });
+    }
+
+    std::string unique_name(const std::string& prefix) {
+        return "/" + prefix + "_" + std::to_string(getpid());
+    }
+
+    TEST(SequenceLockSlotTest, EmptySlotReadsNothing) {
+        shared_memory::SequenceLockSlot<Payload> slot{};
+        Payload payload;
+        EXPECT_EQ(slot.try_read(payload), 0u);
+        EXPECT_EQ(slot.write(Payload::make(7)), 2u);
+        EXPECT_EQ(slot.read(payload), 2u);
+        EXPECT_EQ(payload.value, 7u);
+        EXPECT_TRUE(payload.is_consistent());
+    }
+
+    TEST(SequenceLockSlotTest, ConcurrentReaderNeverSeesTornValue) {
+        constexpr uint64_t kWrites = 200000;
+        shared_memory::SequenceLockSlot<Payload> slot{};
+        std::atomic<bool> done{false};
+
+        std::thread writer([&]() {
+            for(uint64_t k = 1; k <= kWrites; k++)
+                slot.write(Payload::make(k));
+            done.store(true, std::memory_order_release);
+        });
+
+        uint64_t reads = 0, torn = 0, last_value = 0;
+        bool monotonic = true;
+        Payload payload;
+        while(!done.load(std::memory_order_acquire)) {
+            const uint64_t sequence = slot.try_read(payload);
+            if(sequence == 0)
+                continue;
+            reads++;
+            // The k-th write completes with sequence 2k:
+            if(!payload.is_consistent() || sequence != 2 * payload.value)
+                torn++;
+            monotonic &= payload.value >= last_value;
+            last_value = payload.value;
+        }
+        writer.join();
+
+        EXPECT_EQ(torn, 0u);
+        EXPECT_TRUE(monotonic);
+        EXPECT_GT(reads, 0u);
+        ASSERT_EQ(slot.read(payload), 2 * kWrites);
+        EXPECT_EQ(payload.value, kWrites);
+    }
+
+    TEST(TelemetryRingTest, ReaderHandlesHeadOverflow) {
+        const std::string name = unique_name("osc_telemetry_overflow_test");
+        telemetry::TelemetryPublisher<TestDescriptor> publisher;
+        ASSERT_TRUE(publisher.open(name, 8).ok());
+        telemetry::TelemetryReader<TestDescriptor> reader;
+        ASSERT_TRUE(reader.open(name).ok());
+
+        Record record;
+        EXPECT_FALSE(reader.read_latest(record));
+        for(uint64_t n = 0; n < 20; n++)
+            publisher.publish(make_record(n));
+        ASSERT_EQ(reader.head(), 20u);
+
+        // Records [head - capacity, head) are retained, older ones were overwritten:
+        for(uint64_t n = 0; n < 12; n++)
+            EXPECT_FALSE(reader.read(n, record)) << n;
+        for(uint64_t n = 12; n < 20; n++) {
+            ASSERT_TRUE(reader.read(n, record)) << n;
+            EXPECT_EQ(record.tick, n);
+            EXPECT_TRUE(is_consistent(record));
+        }
+        EXPECT_FALSE(reader.read(20, record));
+        ASSERT_TRUE(reader.read_latest(record));
+        EXPECT_EQ(record.tick, 19u);
+
+        EXPECT_TRUE(reader.close().ok());
+        EXPECT_TRUE(publisher.close().ok());
+    }
+
+    TEST(TelemetryRingTest, ConcurrentReaderNeverSeesTornRecord) {
+        constexpr uint64_t kRecords = 100000;
+        constexpr uint32_t kCapacity = 16;
+        const std::string name = unique_name("osc_telemetry_concurrent_test");
+        telemetry::TelemetryPublisher<TestDescriptor> publisher;
+        ASSERT_TRUE(publisher.open(name, kCapacity).ok());
+        telemetry::TelemetryReader<TestDescriptor> reader;
+        ASSERT_TRUE(reader.open(name).ok());
+
+        std::thread writer([&]() {
+            for(uint64_t n = 0; n < kRecords; n++)
+                publisher.publish(make_record(n));
+        });
+
+        // Follow the head, skipping records that were overwritten before they were read:
+        uint64_t next = 0, received = 0, skipped = 0, torn = 0;
+        Record record;
+        while(next < kRecords) {
+            const uint64_t head = reader.head();
+            if(head > next + kCapacity) {
+                skipped += head - kCapacity - next;
+                next = head - kCapacity;
+            }
+            for(; next < head; next++) {
+                if(!reader.read(next, record)) {
+                    skipped++;
+                    continue;
+                }
+                received++;
+                if(record.tick != next || !is_consistent(record))
+                    torn++;
+            }
+        }
+        writer.join();
+
+        EXPECT_EQ(torn, 0u);
+        EXPECT_EQ(received + skipped, kRecords);
+        ASSERT_TRUE(reader.read_latest(record));
+        EXPECT_EQ(record.tick, kRecords - 1);
+
+        EXPECT_TRUE(reader.close().ok());
+        EXPECT_TRUE(publisher.close().ok());
+    }
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "absl/status/status.h"
+
+
+namespace operational_space_controller {
+    namespace trace {
+        // Control tick stages: (Span names in the exported trace)
+        enum class Span : uint8_t {
+            kTick,
+            kModelStage,
+            kSolverStage,
+            kMujocoUpdate,
+            kOSCData,
+            kCasadiEvaluation,
+            kNativeAssembly,
+            kOsqpUpdate,
+            kSolve,
+            kLockWait,
+            kCheckpoint,
+        };
+
+        inline const char* name(Span span) {
+            switch(span) {
+                case Span::kTick: return "Tick";
+                case Span::kModelStage: return "Model Stage";
+                case Span::kSolverStage: return "Solver Stage";
+                case Span::kMujocoUpdate: return "Mujoco Update";
+                case Span::kOSCData: return "OSC Data";
+                case Span::kCasadiEvaluation: return "Casadi Evaluation";
+                case Span::kNativeAssembly: return "Native QP Assembly";
+                case Span::kOsqpUpdate: return "OSQP Update";
+                case Span::kSolve: return "OSQP Solve";
+                case Span::kLockWait: return "Lock Wait";
+                case Span::kCheckpoint: return "Checkpoint";
+            }
+            return "Unknown";
+        }
+
+        inline int64_t now_ns() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count();
+        }
+
+        // Kernel thread id: (Matches the thread ids of other processes' traces)
+        inline uint32_t thread_id() {
+            thread_local const uint32_t id = static_cast<uint32_t>(syscall(SYS_gettid));
+            return id;
+        }
+
+        struct TraceEvent {
+            int64_t begin_ns;
+            int64_t end_ns;
+            uint32_t thread_id;
+            Span span;
+        };
+
+        /*
+            Trace Recorder: Begin/end spans of the control tick in a preallocated buffer.
+            Written as a Chrome Trace Event file (chrome://tracing, ui.perfetto.dev) on write().
+            record() is wait free: one relaxed fetch_add and a store, no allocation. Spans past capacity are dropped.
+            Disabled recorders only cost the is_enabled() branch. Enable before the recording threads start.
+            Timestamps are steady_clock (CLOCK_MONOTONIC) in microseconds.
+        */
+        class TraceRecorder {
+            public:
+                absl::Status enable(const std::filesystem::path& new_path, size_t capacity) {
+                    if(capacity == 0)
+                        return absl::InvalidArgumentError("Trace capacity must be positive.");
+
+                    events.resize(capacity);
+                    path = new_path;
+                    count.store(0, std::memory_order_relaxed);
+                    written = false;
+                    enabled = true;
+                    return absl::OkStatus();
+                }
+
+                bool is_enabled() const {
+                    return enabled;
+                }
+
+                void record(Span span, int64_t begin_ns, int64_t end_ns) {
+                    if(!enabled)
+                        return;
+                    const size_t index = count.fetch_add(1, std::memory_order_relaxed);
+                    if(index < events.size())
+                        events[index] = TraceEvent{begin_ns, end_ns, thread_id(), span};
+                }
+
+                // Labels the calling thread in the trace viewer:
+                void name_thread(const char* thread_name) {
+                    if(!enabled)
+                        return;
+                    const size_t index = named_threads.fetch_add(1, std::memory_order_relaxed);
+                    if(index < thread_names.size())
+                        thread_names[index] = {thread_id(), thread_name};
+                }
+
+                // Writes the recorded spans once: (Call after the recording threads stopped)
+                absl::Status write() {
+                    if(!enabled || written)
+                        return absl::OkStatus();
+                    written = true;
+
+                    std::ofstream file(path);
+                    if(!file)
+                        return absl::InternalError("Failed to open trace file: " + path.string());
+
+                    const int pid = static_cast<int>(getpid());
+                    const size_t recorded = std::min(count.load(std::memory_order_acquire), events.size());
+                    file.setf(std::ios::fixed);
+                    file.precision(3);
+                    file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+                    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+                        << ",\"args\":{\"name\":\"operational_space_controller\"}}";
+                    const size_t named = std::min(named_threads.load(std::memory_order_acquire), thread_names.size());
+                    for(size_t i = 0; i < named; i++) {
+                        file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << thread_names[i].first
+                            << ",\"args\":{\"name\":\"" << thread_names[i].second << "\"}}";
+                    }
+                    for(size_t i = 0; i < recorded; i++) {
+                        const TraceEvent& event = events[i];
+                        file << ",\n{\"name\":\"" << name(event.span) << "\",\"cat\":\"osc\",\"ph\":\"X\",\"pid\":" << pid
+                            << ",\"tid\":" << event.thread_id
+                            << ",\"ts\":" << 1e-3 * event.begin_ns
+                            << ",\"dur\":" << 1e-3 * (event.end_ns - event.begin_ns) << "}";
+                    }
+                    file << "\n],\"otherData\":{\"dropped_spans\":" << dropped() << "}}\n";
+                    file.close();
+                    if(!file)
+                        return absl::InternalError("Failed to write trace file: " + path.string());
+                    return absl::OkStatus();
+                }
+
+                uint64_t dropped() const {
+                    const size_t recorded = count.load(std::memory_order_relaxed);
+                    return recorded > events.size() ? recorded - events.size() : 0;
+                }
+
+            private:
+                bool enabled = false;
+                bool written = false;
+                std::filesystem::path path;
+                std::vector<TraceEvent> events;
+                std::atomic<size_t> count{0};
+                std::array<std::pair<uint32_t, const char*>, 8> thread_names;
+                std::atomic<size_t> named_threads{0};
+        };
+
+        // Records the enclosing scope as one span: (Reads the clock only when tracing is enabled)
+        class ScopedSpan {
+            public:
+                ScopedSpan(TraceRecorder& recorder, Span span) :
+                    recorder(recorder), span(span), begin_ns(recorder.is_enabled() ? now_ns() : 0) {}
+                ~ScopedSpan() {
+                    if(recorder.is_enabled())
+                        recorder.record(span, begin_ns, now_ns());
+                }
+                ScopedSpan(const ScopedSpan&) = delete;
+                ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+            private:
+                TraceRecorder& recorder;
+                Span span;
+                int64_t begin_ns;
+        };
+    }
+}
@@ -2,6 +2,7 @@ from absl import app
 from absl import flags
 
 import os
+import re
 import yaml
 
 import casadi
@@ -14,18 +15,28 @@ from python.runfiles import Runfiles
 
 FLAGS = flags.FLAGS
 flags.DEFINE_string("filepath", None, "Bazel filepath to the autogen folder (This should be automatically determinded by the genrule).")
+flags.DEFINE_string("name", "unitree_go2", "Descriptor name: Used as the C++ namespace and as the prefix of the generated Casadi symbols.")
+flags.DEFINE_string("model_path", "mujoco-models/models/unitree_go2/go2.xml", "Runfiles path to the Mujoco model.")
+flags.DEFINE_string("config_path", "operational-space-controller/config/unitree_go2/unitree_go2_config.yaml", "Runfiles path to the configuration YAML file.")
+# ISA variants of the generated functions: (Same code, each compiled with its own -m flags, see isa_dispatch.h)
+ISA_VARIANTS = ["avx2", "avx512"]
+FUNCTION_NAMES = ["Aeq", "beq", "Aineq", "bineq", "H", "f"]
+
+flags.DEFINE_enum("precision", "double", ["double", "float"], "Scalar type of the generated functions and the controller data (Descriptor::Scalar).")
 
 
 class AutoGen():
-    def __init__(self, mj_model: mujoco.MjModel):
+    def __init__(self, mj_model: mujoco.MjModel, name: str, config_path: str, precision: str = "double"):
         self.mj_model = mj_model
+        self.name = name
+        self.precision = precision
 
         # Parse Configuration YAML File:
         r = Runfiles.Create()
-        with open(r.Rlocation("operational-space-controller/config/unitree_go2/unitree_go2_config.yaml"), "r") as file:
+        with open(r.Rlocation(config_path), "r") as file:
             config = yaml.safe_load(file)
 
-        # Get Weight Configuration:
+        # Get Weight Configuration: (torque and regularization, the task weights are part of the task configuration)
         self.weights_config = config['weights_config']
 
         # Get Body and Site IDs:
@@ -41,20 +52,86 @@ class AutoGen():
 
         assert self.num_body_ids == self.num_site_ids, "Number of body IDs and site IDs must be equal."
 
+        # Floating base models start with a free joint:
+        self.is_fixed_based = not (
+            self.mj_model.njnt > 0
+            and self.mj_model.jnt_type[0] == mujoco.mjtJoint.mjJNT_FREE
+        )
+
+        # Actuator Limits:
+        self.torque_lower_bound = config['torque_limits']['lower']
+        self.torque_upper_bound = config['torque_limits']['upper']
+        assert len(self.torque_lower_bound) == self.mj_model.nu, "Number of lower torque limits must match the number of actuators."
+        assert len(self.torque_upper_bound) == self.mj_model.nu, "Number of upper torque limits must match the number of actuators."
+
         self.dv_size = self.mj_model.nv
         self.u_size = self.mj_model.nu
         self.z_size = self.num_contact_site_ids * 3
+
+        # Taskspace Rows: Only weighted task components are part of the taskspace jacobian and objective
+        self.task_rows = self.parse_tasks(
+            config['tasks'],
+            config['noncontact_site_list'] + config['contact_site_list'],
+        )
+        self.p_size = sum(1 for _, component, _ in self.task_rows if component < 3)
+        self.r_size = len(self.task_rows) - self.p_size
+        self.s_size = len(self.task_rows)
+        assert self.s_size > 0, "At least one task component must have a nonzero weight."
+        # Runtime objective weights: [task weights (per taskspace row), torque, regularization]
+        self.weights_size = self.s_size + 2
         self.design_vector_size = self.dv_size + self.u_size + self.z_size
 
         self.dv_idx = self.dv_size
         self.u_idx = self.dv_idx + self.u_size
         self.z_idx = self.u_idx + self.z_size
 
+        # Actuation matrix: Unactuated (floating base) rows first, none for fixed base models
         self.B: DM = casadi.vertcat(
-            DM.zeros((6, self.u_size)),
+            DM.zeros((self.dv_size - self.u_size, self.u_size)),
             DM.eye(self.u_size),
         )
 
+    def parse_tasks(
+        self,
+        tasks_config: dict,
+        site_names: list[str],
+    ) -> list[tuple[int, int, float]]:
+        """Taskspace rows from the per site task configuration.
+
+        Args:
+            tasks_config: Task weights per site name. Each site has optional
+                'translational' and 'rotational' entries: a weight for all
+                three axes or a list of three per axis weights.
+            site_names: Site names in site_list order.
+
+        Returns:
+            Kept rows as (site index, component, weight): translational rows
+            for each site followed by rotational rows for each site. Components
+            0-2 are the translational axes and 3-5 the rotational axes (the
+            columns of the desired task acceleration). Components that are
+            missing, false or have zero weight are pruned.
+
+        """
+        unknown_sites = set(tasks_config) - set(site_names)
+        assert not unknown_sites, f"Tasks configured for unknown sites: {sorted(unknown_sites)}"
+
+        rows = {'translational': [], 'rotational': []}
+        for site, site_name in enumerate(site_names):
+            task = tasks_config.get(site_name) or {}
+            unknown_components = set(task) - set(rows)
+            assert not unknown_components, f"Unknown task components for site {site_name}: {sorted(unknown_components)}"
+            for offset, component in enumerate(rows):
+                weights = task.get(component) or 0.0
+                if not isinstance(weights, list):
+                    weights = [weights] * 3
+                assert len(weights) == 3, f"{site_name} {component} weights must be a scalar or a list of 3 weights."
+                for axis, weight in enumerate(weights):
+                    assert weight >= 0, f"{site_name} {component} weights must be nonnegative."
+                    if weight:
+                        rows[component].append((site, 3 * offset + axis, float(weight)))
+
+        return rows['translational'] + rows['rotational']
+
     def equality_constraints(
         self,
         q: MX,
@@ -91,11 +168,13 @@ class AutoGen():
     def inequality_constraints(
         self,
         q: MX,
+        mu: MX,
     ) -> MX:
         """Compute inequality constraints for the Operational Space Controller.
 
         Args:
             q: design vector.
+            mu: Friction coefficient.
 
         Returns:
             MX: Inequality constraints.
@@ -110,10 +189,10 @@ class AutoGen():
         z = q[self.u_idx:self.z_idx]
 
         def translational_friction(x: MX) -> MX:
-            constraint_1 = x[0] + x[1] - self.mu * x[2]
-            constraint_2 = -x[0] + x[1] - self.mu * x[2]
-            constraint_3 = x[0] - x[1] - self.mu * x[2]
-            constraint_4 = -x[0] - x[1] - self.mu * x[2]
+            constraint_1 = x[0] + x[1] - mu * x[2]
+            constraint_2 = -x[0] + x[1] - mu * x[2]
+            constraint_3 = x[0] - x[1] - mu * x[2]
+            constraint_4 = -x[0] - x[1] - mu * x[2]
             return casadi.vertcat(constraint_1, constraint_2, constraint_3, constraint_4)
 
         contact_forces = casadi.vertsplit_n(z, self.num_contact_site_ids)
@@ -134,6 +213,7 @@ class AutoGen():
         desired_task_ddx: MX,
         J_task: MX,
         task_bias: MX,
+        weights: MX,
     ) -> MX:
         """Compute the Task Space Tracking Objective.
 
@@ -142,6 +222,7 @@ class AutoGen():
             desired_task_ddx: Desired task acceleration.
             J_task: Taskspace Jacobian.
             task_bias: Taskspace bias acceleration.
+            weights: Objective weights: [task weights (per taskspace row), torque, regularization].
 
         Returns:
             MX: Objective function.
@@ -152,84 +233,48 @@ class AutoGen():
         u = q[self.dv_idx:self.u_idx]
         z = q[self.u_idx:self.z_idx]
 
+        # Unpack Weights:
+        task_weights = weights[:self.s_size]
+        torque_weight = weights[self.s_size]
+        regularization_weight = weights[self.s_size + 1]
+
         # Compute Task Space Tracking Objective:
         ddx_task = J_task @ dv + task_bias
 
-        # Split into Translational and Rotational components:
-        ddx_task_p, ddx_task_r = casadi.vertsplit_n(ddx_task, 2)
-        ddx_base_p, ddx_fr_p, ddx_fl_p, ddx_hr_p, ddx_hl_p = casadi.vertsplit_n(ddx_task_p, self.num_site_ids)
-        ddx_base_r, ddx_fr_r, ddx_fl_r, ddx_hr_r, ddx_hl_r = casadi.vertsplit_n(ddx_task_r, self.num_site_ids)
-
-        # Split Desired Task Acceleration:
-        desired_task_p, desired_task_r = casadi.horzsplit_n(desired_task_ddx, 2)
-        desired_task_p = casadi.vertsplit_n(desired_task_p, self.num_site_ids)
-        desired_task_r = casadi.vertsplit_n(desired_task_r, self.num_site_ids)
-        desired_base_p, desired_fr_p, desired_fl_p, desired_hr_p, desired_hl_p = map(lambda x: x.T, desired_task_p)
-        desired_base_r, desired_fr_r, desired_fl_r, desired_hr_r, desired_hl_r = map(lambda x: x.T, desired_task_r)
-
-        # I could make this more general at the cost of readability...
-        # ddx_task_p = casadi.vertsplit_n(ddx_task_p, self.num_site_ids)
-        # ddx_task_r = casadi.vertsplit_n(ddx_task_r, self.num_site_ids)
-        # desired_task_p = casadi.vertsplit_n(desired_task_p, self.num_site_ids)
-        # desired_task_r = casadi.vertsplit_n(desired_task_r, self.num_site_ids)
+        # Gather Desired Task Acceleration to match the rows of ddx_task: [translational; rotational]
+        desired_task = casadi.vertcat(*[
+            desired_task_ddx[site, component] for site, component, _ in self.task_rows
+        ])
 
         objective_terms = {
-            'base_translational_tracking': self._objective_tracking(
-                ddx_base_p,
-                desired_base_p,
-            ),
-            'base_rotational_tracking': self._objective_tracking(
-                ddx_base_r,
-                desired_base_r,
-            ),
-            'fl_translational_tracking': self._objective_tracking(
-                ddx_fl_p,
-                desired_fl_p,
-            ),
-            'fl_rotational_tracking': self._objective_tracking(
-                ddx_fl_r,
-                desired_fl_r,
+            'tracking': self._objective_tracking(
+                ddx_task,
+                desired_task,
+                task_weights,
             ),
-            'fr_translational_tracking': self._objective_tracking(
-                ddx_fr_p,
-                desired_fr_p,
-            ),
-            'fr_rotational_tracking': self._objective_tracking(
-                ddx_fr_r,
-                desired_fr_r,
-            ),
-            'hl_translational_tracking': self._objective_tracking(
-                ddx_hl_p,
-                desired_hl_p,
-            ),
-            'hl_rotational_tracking': self._objective_tracking(
-                ddx_hl_r,
-                desired_hl_r,
-            ),
-            'hr_translational_tracking': self._objective_tracking(
-                ddx_hr_p,
-                desired_hr_p,
-            ),
-            'hr_rotational_tracking': self._objective_tracking(
-                ddx_hr_r,
-                desired_hr_r,
-            ),
-            'torque': self._objective_regularization(u),
-            'regularization': self._objective_regularization(q),
-        }
-
-        objective_terms = {
-            k: v * self.weights_config[k] for k, v in objective_terms.items()
+            'torque': torque_weight * self._objective_regularization(u),
+            'regularization': regularization_weight * self._objective_regularization(q),
         }
         objective_value = sum(objective_terms.values())
 
         return objective_value
 
+    def task_weights(self) -> list[float]:
+        """Default per row weights of the taskspace tracking objective.
+
+        Returns:
+            Weights ordered as the rows of the taskspace jacobian:
+            translational rows for each site followed by rotational rows
+            for each site (same ordering as gathered in objective).
+
+        """
+        return [weight for _, _, weight in self.task_rows]
+
     def _objective_tracking(
-        self, q: MX, task_target: MX,
+        self, q: MX, task_target: MX, task_weights: MX,
     ) -> MX:
-        """Tracking Objective Function."""
-        return casadi.sumsqr(q - task_target)
+        """Weighted Tracking Objective Function."""
+        return casadi.dot(task_weights, (q - task_target) ** 2)
 
     def _objective_regularization(
         self, q: MX,
@@ -249,8 +294,10 @@ class AutoGen():
         C = casadi.MX.sym("C", self.dv_size)
         J_contact = casadi.MX.sym("J_contact", self.dv_size, self.z_size)
         desired_task_ddx = casadi.MX.sym("desired_task_ddx", self.num_site_ids, 6)
-        J_task = casadi.MX.sym("J_task", self.num_site_ids * 6, self.dv_size)
-        task_bias = casadi.MX.sym("task_bias", self.num_site_ids * 6)
+        J_task = casadi.MX.sym("J_task", self.s_size, self.dv_size)
+        task_bias = casadi.MX.sym("task_bias", self.s_size)
+        weights = casadi.MX.sym("weights", self.weights_size)
+        mu = casadi.MX.sym("mu")
 
         equality_constraint_input = [
             design_vector,
@@ -261,6 +308,7 @@ class AutoGen():
 
         inequality_constraint_input = [
             design_vector,
+            mu,
         ]
 
         objective_input = [
@@ -268,17 +316,18 @@ class AutoGen():
             desired_task_ddx,
             J_task,
             task_bias,
+            weights,
         ]
 
         # Convert to CasADi Function:
         beq = casadi.Function(
-            "beq",
+            f"{self.name}_beq",
             equality_constraint_input,
             [-self.equality_constraints(*equality_constraint_input)],
         )
 
         Aeq = casadi.Function(
-            "Aeq",
+            f"{self.name}_Aeq",
             equality_constraint_input,
             [casadi.densify(casadi.jacobian(
                 self.equality_constraints(*equality_constraint_input),
@@ -287,13 +336,13 @@ class AutoGen():
         )
 
         bineq = casadi.Function(
-            "bineq",
+            f"{self.name}_bineq",
             inequality_constraint_input,
             [-self.inequality_constraints(*inequality_constraint_input)],
         )
 
         Aineq = casadi.Function(
-            "Aineq",
+            f"{self.name}_Aineq",
             inequality_constraint_input,
             [casadi.densify(casadi.jacobian(
                 self.inequality_constraints(*inequality_constraint_input),
@@ -307,13 +356,13 @@ class AutoGen():
         )
 
         H = casadi.Function(
-            "H",
+            f"{self.name}_H",
             objective_input,
             [casadi.densify(hessian)],
         )
 
         f = casadi.Function(
-            "f",
+            f"{self.name}_f",
             objective_input,
             [casadi.densify(gradient)],
         )
@@ -341,6 +390,7 @@ class AutoGen():
         opts = {
             "cpp": True,
             "with_header": True,
+            "casadi_real": self.precision,
         }
         filenames = [
             "autogen_functions",
@@ -358,53 +408,155 @@ class AutoGen():
             for function in casadi_function:
                 generator.add(function)
         generator.generate(FLAGS.filepath+"/")
+        self.spell_out_scalar(os.path.join(FLAGS.filepath, "autogen_functions.h"))
+
+        # ISA variant copies: Generated as plain C so the translation units built with the variant's -m flags
+        # contain no C++ inline functions (standard library, Eigen) that the linker could share with the baseline.
+        # Internal symbols take the per file CASADI_PREFIX and exported symbols are renamed to <name>_<variant>_*.
+        for variant in ISA_VARIANTS:
+            filename = f"autogen_functions_{variant}"
+            generator = casadi.CodeGenerator(f"{filename}.c", {**opts, "cpp": False})
+            for function in [beq, Aeq, bineq, Aineq, H, f]:
+                generator.add(function)
+            generator.generate(FLAGS.filepath+"/")
+            for extension in ["c", "h"]:
+                path = os.path.join(FLAGS.filepath, f"{filename}.{extension}")
+                with open(path, "r") as file:
+                    source = file.read()
+                source = source.replace(f"{self.name}_", f"{self.name}_{variant}_")
+                with open(path, "w") as file:
+                    file.write(source)
+            self.spell_out_scalar(os.path.join(FLAGS.filepath, f"{filename}.h"))
+
+    def spell_out_scalar(self, header_path: str):
+        # Spell out the scalar type in the header declarations: (casadi_real is a macro, so headers
+        # of descriptors with different precisions could not be included in the same translation unit)
+        with open(header_path, "r") as f:
+            header = f.read()
+        header = re.sub(r"#ifndef casadi_real\n#define casadi_real \w+\n#endif\n", "", header)
+        header = header.replace("casadi_real", self.precision)
+        with open(header_path, "w") as f:
+            f.write(header)
 
     def generate_defines(self):
+        def format_array(values) -> str:
+            return ", ".join(str(float(value)) for value in values)
+
+        def function_table(prefix: str) -> str:
+            operations = ",\n                    ".join(
+                f"{{{prefix}_{name}_incref, {prefix}_{name}_checkout, {prefix}_{name}, {prefix}_{name}_release, {prefix}_{name}_decref}}"
+                for name in FUNCTION_NAMES
+            )
+            return f"FunctionTable<Scalar>{{\n                    {operations}\n                }}"
+
+        variant_includes = "\n".join(f'#include "autogen_functions_{variant}.h"' for variant in ISA_VARIANTS)
+        variant_tables = ",\n                ".join(
+            function_table(prefix) for prefix in [self.name] + [f"{self.name}_{variant}" for variant in ISA_VARIANTS]
+        )
+
+        def function_params(function_name: str, rows: str, cols: str, size: str, num_args: int) -> str:
+            symbol = f"{self.name}_{function_name}"
+            return f"""using {function_name}Params =
+                FunctionParams<{symbol}_SZ_ARG, {symbol}_SZ_RES, {symbol}_SZ_IW, {symbol}_SZ_W, optimization::{rows}, {cols}, optimization::{size}, {num_args}, Scalar>;"""
+
         cc_code = f"""#pragma once
 #include <array>
 #include <string_view>
 
-using namespace std::string_view_literals;
-
-namespace operational_space_controller::constants {{
-    namespace model {{
-        // Mujoco Model Constants:
-        constexpr int nq_size  = {self.mj_model.nq};
-        constexpr int nv_size = {self.mj_model.nv};
-        constexpr int nu_size  = {self.mj_model.nu};
-        constexpr int body_ids_size = {self.num_body_ids};
-        constexpr int site_ids_size = {self.num_site_ids};
-        constexpr int noncontact_site_ids_size = {self.num_noncontact_site_ids};
-        constexpr int contact_site_ids_size = {self.num_contact_site_ids};
-        constexpr std::array body_list = {{{", ".join(self.body_list)}}};
-        constexpr std::array site_list = {{{", ".join(self.site_list)}}};
-        constexpr std::array noncontact_site_list = {{{", ".join(self.noncontact_site_list)}}};
-        constexpr std::array contact_site_list = {{{", ".join(self.contact_site_list)}}};
-    }}
-    namespace optimization {{
-        // Optimization Constants:
-        constexpr int dv_size = {self.dv_size};
-        constexpr int u_size = {self.u_size};
-        constexpr int z_size = {self.z_size};
-        constexpr int design_vector_size = {self.design_vector_size};
-        constexpr int dv_idx = {self.dv_idx};
-        constexpr int u_idx = {self.u_idx};
-        constexpr int z_idx = {self.z_idx};
-        constexpr int beq_sz = {self.beq_sz};
-        constexpr int Aeq_sz = {self.Aeq_sz};
-        constexpr int Aeq_rows = {self.Aeq_rows};
-        constexpr int Aeq_cols = {self.Aeq_cols};
-        constexpr int bineq_sz = {self.bineq_sz};
-        constexpr int Aineq_sz = {self.Aineq_sz};
-        constexpr int Aineq_rows = {self.Aineq_rows};
-        constexpr int Aineq_cols = {self.Aineq_cols};
-        constexpr int H_sz = {self.H_sz};
-        constexpr int H_rows = {self.H_rows};
-        constexpr int H_cols = {self.H_cols};
-        constexpr int f_sz = {self.f_sz};
-    }}
+#include "operational-space-control/function_utilities.h"
+#include "autogen_functions.h"
+{variant_includes}
+
+
+namespace operational_space_controller::{self.name} {{
+    using namespace std::string_view_literals;
+
+    struct Descriptor {{
+        // Scalar type of the generated functions and the controller data:
+        using Scalar = {self.precision};
+        struct model {{
+            // Mujoco Model Constants:
+            static constexpr int nq_size  = {self.mj_model.nq};
+            static constexpr int nv_size = {self.mj_model.nv};
+            static constexpr int nu_size  = {self.mj_model.nu};
+            static constexpr int body_ids_size = {self.num_body_ids};
+            static constexpr int site_ids_size = {self.num_site_ids};
+            static constexpr int noncontact_site_ids_size = {self.num_noncontact_site_ids};
+            static constexpr int contact_site_ids_size = {self.num_contact_site_ids};
+            static constexpr std::array body_list = {{{", ".join(self.body_list)}}};
+            static constexpr std::array site_list = {{{", ".join(self.site_list)}}};
+            static constexpr std::array noncontact_site_list = {{{", ".join(self.noncontact_site_list)}}};
+            static constexpr std::array contact_site_list = {{{", ".join(self.contact_site_list)}}};
+        }};
+        struct optimization {{
+            // Optimization Constants:
+            static constexpr int dv_size = {self.dv_size};
+            static constexpr int u_size = {self.u_size};
+            static constexpr int z_size = {self.z_size};
+            static constexpr int design_vector_size = {self.design_vector_size};
+            static constexpr int dv_idx = {self.dv_idx};
+            static constexpr int u_idx = {self.u_idx};
+            static constexpr int z_idx = {self.z_idx};
+            static constexpr int beq_sz = {self.beq_sz};
+            static constexpr int Aeq_sz = {self.Aeq_sz};
+            static constexpr int Aeq_rows = {self.Aeq_rows};
+            static constexpr int Aeq_cols = {self.Aeq_cols};
+            static constexpr int bineq_sz = {self.bineq_sz};
+            static constexpr int Aineq_sz = {self.Aineq_sz};
+            static constexpr int Aineq_rows = {self.Aineq_rows};
+            static constexpr int Aineq_cols = {self.Aineq_cols};
+            static constexpr int H_sz = {self.H_sz};
+            static constexpr int H_rows = {self.H_rows};
+            static constexpr int H_cols = {self.H_cols};
+            static constexpr int f_sz = {self.f_sz};
+            // Taskspace Rows: Weighted task components only, [translational rows; rotational rows] in site order
+            // s_size : Number of taskspace rows
+            static constexpr int s_size = {self.s_size};
+            // p_size : Number of translational taskspace rows: (Rows [0, p_size))
+            static constexpr int p_size = {self.p_size};
+            // r_size : Number of rotational taskspace rows: (Rows [p_size, s_size))
+            static constexpr int r_size = {self.r_size};
+            // task_sites : Site of each taskspace row (Row of the taskspace targets)
+            static constexpr std::array<int, s_size> task_sites = {{{", ".join(str(site) for site, _, _ in self.task_rows)}}};
+            // task_components : Component of each taskspace row (Column of the taskspace targets: 0-2 translational, 3-5 rotational)
+            static constexpr std::array<int, s_size> task_components = {{{", ".join(str(component) for _, component, _ in self.task_rows)}}};
+            // Constraint Matrix Size:
+            static constexpr int constraint_matrix_rows = Aeq_rows + Aineq_rows + design_vector_size;
+            static constexpr int constraint_matrix_cols = design_vector_size;
+            static constexpr int bounds_size = beq_sz + bineq_sz + design_vector_size;
+            static constexpr int weights_size = {self.weights_size};
+            // Default Friction Pyramid Coefficient:
+            static constexpr double friction_coefficient = {float(self.mu)};
+        }};
+        struct weights {{
+            // Default Objective Weights: (Taskspace weights are per row of the taskspace jacobian)
+            static constexpr std::array<double, optimization::s_size> task = {{{format_array(self.task_weights())}}};
+            static constexpr double torque = {float(self.weights_config['torque'])};
+            static constexpr double regularization = {float(self.weights_config['regularization'])};
+        }};
+        struct limits {{
+            // Actuator Limits:
+            static constexpr std::array<double, model::nu_size> torque_lower_bound = {{{format_array(self.torque_lower_bound)}}};
+            static constexpr std::array<double, model::nu_size> torque_upper_bound = {{{format_array(self.torque_upper_bound)}}};
+        }};
+        struct functions {{
+            // Function tables per ISA variant: (Indexed by isa_dispatch::IsaVariant)
+            static constexpr std::array<FunctionTable<Scalar>, {1 + len(ISA_VARIANTS)}> isa_variants = {{{{
+                {variant_tables}
+            }}}};
+
+            // Casadi Functions
+            {function_params("Aeq", "Aeq_rows", "optimization::Aeq_cols", "Aeq_sz", 4)}
+            {function_params("beq", "beq_sz", "1", "beq_sz", 4)}
+            {function_params("Aineq", "Aineq_rows", "optimization::Aineq_cols", "Aineq_sz", 2)}
+            {function_params("bineq", "bineq_sz", "1", "bineq_sz", 2)}
+            {function_params("H", "H_rows", "optimization::H_cols", "H_sz", 5)}
+            {function_params("f", "f_sz", "1", "f_sz", 5)}
+        }};
+        static constexpr bool is_fixed_based = {"true" if self.is_fixed_based else "false"};
+    }};
 }}
-        """
+"""
 
         filepath = os.path.join(FLAGS.filepath, "autogen_defines.h")
         with open(filepath, "w") as f:
@@ -416,12 +568,12 @@ def main(argv):
     r = Runfiles.Create()
     mj_model = mujoco.MjModel.from_xml_path(
         r.Rlocation(
-            path="mujoco-models/models/unitree_go2/go2.xml",
+            path=FLAGS.model_path,
         )
     )
 
     # Generate Functions:
-    autogen = AutoGen(mj_model)
+    autogen = AutoGen(mj_model, FLAGS.name, FLAGS.config_path, FLAGS.precision)
     autogen.generate_functions()
     autogen.generate_defines()
 
@@ -0,0 +1,348 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "absl/status/status.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/aliases.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/containers.h"
+
+
+namespace operational_space_controller::unitree_go2 {
+    namespace low_level {
+        /*
+            Unitree Go2 Low Level Messages: Raw layout of the LowState / LowCmd messages, naturally aligned like the
+            SDK's unitree_go::msg::dds_::LowState_ and LowCmd_. (Padding included, the crc is the last word)
+            Motors are indexed FR, FL, RR, RL (hip, thigh, calf), feet FR, FL, RR, RL. 20 motor slots, 12 used.
+        */
+        constexpr int kMotorSlots = 20;
+        constexpr int kMotors = 12;
+        constexpr int kFeet = 4;
+
+        struct ImuState {
+            // Orientation: (w, x, y, z)
+            float quaternion[4];
+            // Body frame angular velocity (rad/s) and specific force (m/s^2):
+            float gyroscope[3];
+            float accelerometer[3];
+            float rpy[3];
+            int8_t temperature;
+        };
+
+        struct MotorState {
+            uint8_t mode;
+            float q;
+            float dq;
+            float ddq;
+            float tau_est;
+            float q_raw;
+            float dq_raw;
+            float ddq_raw;
+            int8_t temperature;
+            uint32_t lost;
+            uint32_t reserve[2];
+        };
+
+        struct BmsState {
+            uint8_t version_high;
+            uint8_t version_low;
+            uint8_t status;
+            uint8_t soc;
+            int32_t current;
+            uint16_t cycle;
+            int8_t bq_ntc[2];
+            int8_t mcu_ntc[2];
+            uint16_t cell_vol[15];
+        };
+
+        struct LowState {
+            uint8_t head[2];
+            uint8_t level_flag;
+            uint8_t frame_reserve;
+            uint32_t sn[2];
+            uint32_t version[2];
+            uint16_t bandwidth;
+            ImuState imu_state;
+            MotorState motor_state[kMotorSlots];
+            BmsState bms_state;
+            int16_t foot_force[kFeet];
+            int16_t foot_force_est[kFeet];
+            uint32_t tick;
+            uint8_t wireless_remote[40];
+            uint8_t bit_flag;
+            float adc_reel;
+            int8_t temperature_ntc1;
+            int8_t temperature_ntc2;
+            float power_v;
+            float power_a;
+            uint16_t fan_frequency[4];
+            uint32_t reserve;
+            uint32_t crc;
+        };
+
+        struct MotorCmd {
+            uint8_t mode;
+            float q;
+            float dq;
+            float tau;
+            float kp;
+            float kd;
+            uint32_t reserve[3];
+        };
+
+        struct BmsCmd {
+            uint8_t off;
+            uint8_t reserve[3];
+        };
+
+        struct LowCmd {
+            uint8_t head[2];
+            uint8_t level_flag;
+            uint8_t frame_reserve;
+            uint32_t sn[2];
+            uint32_t version[2];
+            uint16_t bandwidth;
+            MotorCmd motor_cmd[kMotorSlots];
+            BmsCmd bms_cmd;
+            uint8_t wireless_remote[40];
+            uint8_t led[12];
+            uint8_t fan[2];
+            uint8_t gpio;
+            uint32_t reserve;
+            uint32_t crc;
+        };
+
+        // Layout of the SDK messages: (The CRC covers every word before crc, padding bytes included)
+        static_assert(sizeof(ImuState) == 56);
+        static_assert(sizeof(MotorState) == 48 && offsetof(MotorState, temperature) == 32 && offsetof(MotorState, lost) == 36);
+        static_assert(sizeof(BmsState) == 44 && offsetof(BmsState, current) == 4 && offsetof(BmsState, cell_vol) == 14);
+        static_assert(sizeof(LowState) == 1180);
+        static_assert(offsetof(LowState, bandwidth) == 20 && offsetof(LowState, imu_state) == 24);
+        static_assert(offsetof(LowState, motor_state) == 80 && offsetof(LowState, bms_state) == 1040);
+        static_assert(offsetof(LowState, foot_force) == 1084 && offsetof(LowState, tick) == 1100);
+        static_assert(offsetof(LowState, adc_reel) == 1148 && offsetof(LowState, power_v) == 1156);
+        static_assert(offsetof(LowState, crc) == sizeof(LowState) - 4);
+        static_assert(sizeof(MotorCmd) == 36 && offsetof(MotorCmd, q) == 4);
+        static_assert(sizeof(LowCmd) == 812);
+        static_assert(offsetof(LowCmd, motor_cmd) == 24 && offsetof(LowCmd, bms_cmd) == 744);
+        static_assert(offsetof(LowCmd, wireless_remote) == 748 && offsetof(LowCmd, gpio) == 802);
+        static_assert(offsetof(LowCmd, crc) == sizeof(LowCmd) - 4);
+
+        // Low level command constants: (Position and velocity stop values disable the motor driver's PD loop terms)
+        constexpr uint8_t kHead[2] = {0xFE, 0xEF};
+        constexpr uint8_t kLowLevelFlag = 0xFF;
+        constexpr uint8_t kServoMode = 0x01;
+        constexpr float kPositionStop = 2.146e9f;
+        constexpr float kVelocityStop = 16000.0f;
+
+        constexpr uint32_t kCrc32Polynomial = 0x04C11DB7;
+
+        constexpr std::array<uint32_t, 256> make_crc32_table() {
+            std::array<uint32_t, 256> table{};
+            for(uint32_t i = 0; i < 256; i++) {
+                uint32_t crc = i << 24;
+                for(int bit = 0; bit < 8; bit++)
+                    crc = (crc & 0x80000000) ? (crc << 1) ^ kCrc32Polynomial : crc << 1;
+                table[i] = crc;
+            }
+            return table;
+        }
+
+        inline constexpr std::array<uint32_t, 256> kCrc32Table = make_crc32_table();
+
+        /*
+            Unitree CRC: CRC-32 (polynomial 0x04c11db7, initial value 0xffffffff, MSB first, no final xor) over the
+            32 bit words in host order. Same value as the SDK's bitwise crc32_core with one table lookup per byte.
+        */
+        inline uint32_t crc32_core(const void* data, size_t words) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            uint32_t crc = 0xFFFFFFFF;
+            for(size_t i = 0; i < words; i++) {
+                uint32_t word;
+                std::memcpy(&word, bytes + 4 * i, sizeof(word));
+                for(int shift = 24; shift >= 0; shift -= 8)
+                    crc = (crc << 8) ^ kCrc32Table[((crc >> 24) ^ (word >> shift)) & 0xFF];
+            }
+            return crc;
+        }
+
+        // CRC of a message: (Every word before the trailing crc field, as the SDK computes it)
+        template <typename Message>
+        uint32_t message_crc(const Message& message) {
+            return crc32_core(&message, (sizeof(Message) >> 2) - 1);
+        }
+
+        /*
+            Adapter Settings:
+                motor_index             : Unitree motor slot of each controller actuator (Descriptor actuator order)
+                foot_index              : Unitree foot of each contact site (Descriptor contact_site_list order)
+                contact_force_threshold : Foot force (raw sensor units) above which a foot is in contact
+                damping                 : Motor driver joint damping kd, 0 for pure torque control
+        */
+        struct AdapterSettings {
+            std::array<int, model::nu_size> motor_index = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+            std::array<int, model::contact_site_ids_size> foot_index = {0, 1, 2, 3};
+            double contact_force_threshold = 20.0;
+            float damping = 0.0f;
+        };
+
+        /*
+            Low Level Adapter: Decodes LowState messages straight into the controller's State and encodes torques
+            straight into a persistent LowCmd buffer, without intermediate vectors.
+            The constant fields of the command (header, modes, stop values and gains) are written once.
+        */
+        class LowLevelAdapter {
+            public:
+                explicit LowLevelAdapter(const AdapterSettings& settings = AdapterSettings()) : settings(settings) {
+                    std::memset(&low_cmd, 0, sizeof(LowCmd));
+                    low_cmd.head[0] = kHead[0];
+                    low_cmd.head[1] = kHead[1];
+                    low_cmd.level_flag = kLowLevelFlag;
+                    for(int i = 0; i < model::nu_size; i++) {
+                        MotorCmd& motor_cmd = low_cmd.motor_cmd[settings.motor_index[i]];
+                        motor_cmd.mode = kServoMode;
+                        motor_cmd.q = kPositionStop;
+                        motor_cmd.dq = kVelocityStop;
+                        motor_cmd.kp = 0.0f;
+                        motor_cmd.kd = settings.damping;
+                        motor_cmd.tau = 0.0f;
+                    }
+                    low_cmd.crc = message_crc(low_cmd);
+                }
+
+                /*
+                    Checks the CRC and writes the motor states, the IMU orientation and angular velocity, the
+                    accelerometer and the foot contacts into state. Fields the low level state does not carry
+                    (linear_body_velocity) are left to the caller's estimator. The timestamp and sequence are
+                    cleared, so update_state() stamps the sample.
+                */
+                absl::Status decode(const LowState& message, State& state) const {
+                    if(message_crc(message) != message.crc)
+                        return absl::DataLossError("Low level state CRC mismatch.");
+
+                    for(int i = 0; i < model::nu_size; i++) {
+                        const MotorState& motor_state = message.motor_state[settings.motor_index[i]];
+                        state.motor_position(i) = motor_state.q;
+                        state.motor_velocity(i) = motor_state.dq;
+                        state.motor_acceleration(i) = motor_state.ddq;
+                        state.torque_estimate(i) = motor_state.tau_est;
+                    }
+                    const ImuState& imu_state = message.imu_state;
+                    state.body_rotation = Eigen::Map<const Vector<4, float>>(imu_state.quaternion).cast<double>();
+                    state.angular_body_velocity = Eigen::Map<const Vector<3, float>>(imu_state.gyroscope).cast<double>();
+                    state.linear_body_acceleration = Eigen::Map<const Vector<3, float>>(imu_state.accelerometer).cast<double>();
+                    for(int i = 0; i < model::contact_site_ids_size; i++)
+                        state.contact_mask(i) = message.foot_force[settings.foot_index[i]] > settings.contact_force_threshold ? 1.0 : 0.0;
+                    state.timestamp_ns = 0;
+                    state.sequence = 0;
+                    return absl::OkStatus();
+                }
+
+                // Writes the torques and the CRC into the command buffer: (Send the returned buffer as is)
+                const LowCmd& encode(const Eigen::Ref<const Vector<model::nu_size>>& torque) {
+                    for(int i = 0; i < model::nu_size; i++)
+                        low_cmd.motor_cmd[settings.motor_index[i]].tau = static_cast<float>(torque(i));
+                    low_cmd.crc = message_crc(low_cmd);
+                    return low_cmd;
+                }
+
+                const LowCmd& command() const {
+                    return low_cmd;
+                }
+
+            private:
+                AdapterSettings settings;
+                LowCmd low_cmd;
+        };
+
+        /*
+            UDP Endpoint: Loopback stand-in for the robot's low level channels.
+            Messages are sent from and received into the message structs, so a received LowState is decoded in place.
+            (The Go2 itself publishes over DDS, see the unitree_sdk2 LowState / LowCmd channels)
+        */
+        class UdpEndpoint {
+            public:
+                UdpEndpoint() = default;
+                UdpEndpoint(const UdpEndpoint&) = delete;
+                UdpEndpoint& operator=(const UdpEndpoint&) = delete;
+                ~UdpEndpoint() { std::ignore = close(); }
+
+                // Receives on local_port and sends to remote_port of address:
+                absl::Status open(uint16_t local_port, uint16_t remote_port, const std::string& address = "127.0.0.1") {
+                    if(is_open())
+                        return absl::FailedPreconditionError("UDP endpoint already open.");
+
+                    sockaddr_in local{};
+                    local.sin_family = AF_INET;
+                    local.sin_port = htons(local_port);
+                    remote = sockaddr_in{};
+                    remote.sin_family = AF_INET;
+                    remote.sin_port = htons(remote_port);
+                    if(inet_pton(AF_INET, address.c_str(), &local.sin_addr) != 1 || inet_pton(AF_INET, address.c_str(), &remote.sin_addr) != 1)
+                        return absl::InvalidArgumentError("Invalid UDP address: " + address);
+
+                    socket_fd = socket(AF_INET, SOCK_DGRAM, 0);
+                    if(socket_fd == -1)
+                        return absl::InternalError("Failed to create UDP socket.");
+                    if(bind(socket_fd, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) == -1) {
+                        std::ignore = close();
+                        return absl::UnavailableError("Failed to bind UDP port " + std::to_string(local_port) + ".");
+                    }
+                    return absl::OkStatus();
+                }
+
+                absl::Status close() {
+                    if(!is_open())
+                        return absl::OkStatus();
+                    ::close(socket_fd);
+                    socket_fd = -1;
+                    return absl::OkStatus();
+                }
+
+                bool is_open() const {
+                    return socket_fd != -1;
+                }
+
+                template <typename Message>
+                absl::Status send(const Message& message) {
+                    const ssize_t sent = sendto(socket_fd, &message, sizeof(Message), 0, reinterpret_cast<const sockaddr*>(&remote), sizeof(remote));
+                    if(sent != static_cast<ssize_t>(sizeof(Message)))
+                        return absl::UnavailableError("Failed to send UDP message.");
+                    return absl::OkStatus();
+                }
+
+                // Waits up to timeout_ms for a message: (0 polls, DeadlineExceededError if none arrived)
+                template <typename Message>
+                absl::Status receive(Message& message, int timeout_ms) {
+                    pollfd poll_fd{socket_fd, POLLIN, 0};
+                    const int ready = poll(&poll_fd, 1, timeout_ms);
+                    if(ready == 0)
+                        return absl::DeadlineExceededError("No UDP message received.");
+                    if(ready == -1)
+                        return absl::InternalError("Failed to poll UDP socket.");
+
+                    const ssize_t received = recv(socket_fd, &message, sizeof(Message), 0);
+                    if(received != static_cast<ssize_t>(sizeof(Message)))
+                        return absl::DataLossError("UDP message size mismatch.");
+                    return absl::OkStatus();
+                }
+
+            private:
+                int socket_fd = -1;
+                sockaddr_in remote{};
+        };
+    }
+}
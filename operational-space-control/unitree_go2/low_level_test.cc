@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "Eigen/Dense"
+
+#include "operational-space-control/aliases.h"
+#include "operational-space-control/unitree_go2/constants.h"
+#include "operational-space-control/unitree_go2/containers.h"
+#include "operational-space-control/unitree_go2/low_level.h"
+
+using namespace operational_space_controller::aliases;
+using namespace operational_space_controller::unitree_go2;
+using namespace operational_space_controller::unitree_go2::low_level;
+
+
+/*
+    Low Level Tests: The table driven CRC against a known vector and the SDK's bitwise crc32_core,
+    and a LowState decode / LowCmd encode round trip over two loopback UDP endpoints.
+*/
+namespace {
+    // Reference: (The SDK's bitwise crc32_core)
+    uint32_t crc32_core_bitwise(const uint32_t* data, uint32_t words) {
+        uint32_t crc = 0xFFFFFFFF;
+        for(uint32_t i = 0; i < words; i++) {
+            uint32_t bit = 1u << 31;
+            for(uint32_t b = 0; b < 32; b++) {
+                crc = (crc & 0x80000000) ? (crc << 1) ^ kCrc32Polynomial : crc << 1;
+                if(data[i] & bit)
+                    crc ^= kCrc32Polynomial;
+                bit >>= 1;
+            }
+        }
+        return crc;
+    }
+
+    template <typename Message>
+    void fill_random(Message& message, uint32_t seed) {
+        std::mt19937 generator(seed);
+        unsigned char* bytes = reinterpret_cast<unsigned char*>(&message);
+        for(size_t i = 0; i < sizeof(Message); i++)
+            bytes[i] = static_cast<unsigned char>(generator());
+    }
+
+    TEST(CrcTest, MatchesKnownVector) {
+        // Words are processed most significant byte first: (CRC-32/MPEG-2 of "12345678")
+        const std::array<uint32_t, 3> words = {0x31323334, 0x35363738, 0};
+        EXPECT_EQ(crc32_core(words.data(), 2), 0x49E3C2FBu);
+        EXPECT_EQ(crc32_core_bitwise(words.data(), 2), 0x49E3C2FBu);
+
+        // No final xor: (Appending the CRC leaves a zero remainder)
+        std::array<uint32_t, 3> checked = words;
+        checked[2] = crc32_core(words.data(), 2);
+        EXPECT_EQ(crc32_core(checked.data(), 3), 0u);
+    }
+
+    TEST(CrcTest, MessageCrcMatchesSdkCrc) {
+        for(uint32_t seed = 0; seed < 8; seed++) {
+            LowState low_state;
+            fill_random(low_state, seed);
+            EXPECT_EQ(message_crc(low_state), crc32_core_bitwise(reinterpret_cast<const uint32_t*>(&low_state), (sizeof(LowState) >> 2) - 1));
+            LowCmd low_cmd;
+            fill_random(low_cmd, seed);
+            EXPECT_EQ(message_crc(low_cmd), crc32_core_bitwise(reinterpret_cast<const uint32_t*>(&low_cmd), (sizeof(LowCmd) >> 2) - 1));
+        }
+    }
+
+    TEST(CrcTest, CoversEveryByteBeforeCrc) {
+        LowState low_state;
+        fill_random(low_state, 1);
+        low_state.crc = message_crc(low_state);
+        LowLevelAdapter adapter;
+        State state;
+        ASSERT_TRUE(adapter.decode(low_state, state).ok());
+
+        unsigned char* bytes = reinterpret_cast<unsigned char*>(&low_state);
+        for(size_t i = 0; i < offsetof(LowState, crc); i++) {
+            bytes[i] ^= 0x01;
+            EXPECT_TRUE(absl::IsDataLoss(adapter.decode(low_state, state))) << "byte " << i;
+            bytes[i] ^= 0x01;
+        }
+    }
+
+    class LoopbackTest : public ::testing::Test {
+        protected:
+            static constexpr uint16_t kStatePort = 47301;
+            static constexpr uint16_t kCommandPort = 47302;
+
+            void SetUp() override {
+                ASSERT_TRUE(robot.open(kCommandPort, kStatePort).ok());
+                ASSERT_TRUE(controller.open(kStatePort, kCommandPort).ok());
+            }
+
+            UdpEndpoint robot;
+            UdpEndpoint controller;
+    };
+
+    TEST_F(LoopbackTest, DecodeEncodeRoundTrip) {
+        LowState low_state;
+        std::memset(&low_state, 0, sizeof(LowState));
+        for(int i = 0; i < kMotors; i++) {
+            low_state.motor_state[i].q = 0.1f * i;
+            low_state.motor_state[i].dq = -0.2f * i;
+            low_state.motor_state[i].ddq = 0.5f * i;
+            low_state.motor_state[i].tau_est = 1.5f * i;
+        }
+        const std::array<float, 4> quaternion = {1.0f, 0.0f, 0.0f, 0.0f};
+        std::copy(quaternion.begin(), quaternion.end(), low_state.imu_state.quaternion);
+        low_state.imu_state.gyroscope[2] = 0.25f;
+        low_state.imu_state.accelerometer[2] = 9.81f;
+        low_state.foot_force[0] = 100;
+        low_state.foot_force[3] = 5;
+        low_state.crc = message_crc(low_state);
+        ASSERT_TRUE(robot.send(low_state).ok());
+
+        // Controller side: (Decoded straight out of the received buffer)
+        LowState received_state;
+        ASSERT_TRUE(controller.receive(received_state, 1000).ok());
+        LowLevelAdapter adapter;
+        State state;
+        state.timestamp_ns = 7;
+        ASSERT_TRUE(adapter.decode(received_state, state).ok());
+        for(int i = 0; i < model::nu_size; i++) {
+            EXPECT_FLOAT_EQ(state.motor_position(i), 0.1f * i);
+            EXPECT_FLOAT_EQ(state.motor_velocity(i), -0.2f * i);
+            EXPECT_FLOAT_EQ(state.motor_acceleration(i), 0.5f * i);
+            EXPECT_FLOAT_EQ(state.torque_estimate(i), 1.5f * i);
+        }
+        EXPECT_EQ(state.body_rotation, Vector<4>(1.0, 0.0, 0.0, 0.0));
+        EXPECT_FLOAT_EQ(state.angular_body_velocity(2), 0.25f);
+        EXPECT_FLOAT_EQ(state.linear_body_acceleration(2), 9.81f);
+        EXPECT_EQ(state.contact_mask, Vector<model::contact_site_ids_size>(1.0, 0.0, 0.0, 0.0));
+        EXPECT_EQ(state.timestamp_ns, 0);
+
+        Vector<model::nu_size> torque;
+        for(int i = 0; i < model::nu_size; i++)
+            torque(i) = 2.0 * i - 5.0;
+        ASSERT_TRUE(controller.send(adapter.encode(torque)).ok());
+
+        // Robot side:
+        LowCmd low_cmd;
+        ASSERT_TRUE(robot.receive(low_cmd, 1000).ok());
+        EXPECT_EQ(message_crc(low_cmd), low_cmd.crc);
+        EXPECT_EQ(std::memcmp(&low_cmd, &adapter.command(), sizeof(LowCmd)), 0);
+        EXPECT_EQ(low_cmd.head[0], kHead[0]);
+        EXPECT_EQ(low_cmd.head[1], kHead[1]);
+        EXPECT_EQ(low_cmd.level_flag, kLowLevelFlag);
+        for(int i = 0; i < kMotors; i++) {
+            EXPECT_EQ(low_cmd.motor_cmd[i].mode, kServoMode);
+            EXPECT_EQ(low_cmd.motor_cmd[i].q, kPositionStop);
+            EXPECT_EQ(low_cmd.motor_cmd[i].dq, kVelocityStop);
+            EXPECT_FLOAT_EQ(low_cmd.motor_cmd[i].tau, 2.0f * i - 5.0f);
+        }
+        // Unused motor slots stay off:
+        EXPECT_EQ(low_cmd.motor_cmd[kMotors].mode, 0);
+    }
+
+    TEST_F(LoopbackTest, CorruptedStateIsRejected) {
+        LowState low_state;
+        std::memset(&low_state, 0, sizeof(LowState));
+        low_state.crc = message_crc(low_state);
+        // Last byte before crc: (Outside the CRC of a packed LowState)
+        low_state.reserve ^= 0xFF000000;
+        ASSERT_TRUE(robot.send(low_state).ok());
+
+        LowState received_state;
+        ASSERT_TRUE(controller.receive(received_state, 1000).ok());
+        LowLevelAdapter adapter;
+        State state;
+        EXPECT_TRUE(absl::IsDataLoss(adapter.decode(received_state, state)));
+
+        // Nothing else was sent:
+        EXPECT_TRUE(absl::IsDeadlineExceeded(controller.receive(received_state, 0)));
+    }
+}